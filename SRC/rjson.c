@@ -1,12 +1,45 @@
-#include "rjson.h"
+#include "rjson_internal.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <ctype.h>
-#include <errno.h>
 #include <math.h>  
-
-#define RJSON_MAX_DEPTH 512
+#include <stdint.h>
+#include <stdatomic.h>
+
+#define RJSON_MAX_DEPTH 512 // Default parse depth limit
+
+// Inputs shorter than this are parsed without a structural index: building
+// it costs an allocation and a pass that small documents do not amortize.
+#ifndef RJSON_INDEX_MIN_LENGTH
+#define RJSON_INDEX_MIN_LENGTH 4096
+#endif
+
+// Objects with at least this many members get a hash index of their keys
+// (see struct rjson_object_index); smaller ones are scanned linearly.
+#ifndef RJSON_OBJECT_INDEX_MIN
+#define RJSON_OBJECT_INDEX_MIN 16
+#endif
+
+// Longest number left unconverted by RJSON_PARSE_LAZY_NUMBERS. Without an
+// exponent, a number this short can never overflow a double, so deferring
+// its conversion cannot hide a parse error.
+#define RJSON_LAZY_NUMBER_MAX_LENGTH 64
+
+// Parser core: the table-driven state machine (1) or the switch-based
+// dispatcher (0). Both accept exactly the same documents.
+#ifndef RJSON_TABLE_PARSER
+#define RJSON_TABLE_PARSER 1
+#endif
+
+// The table-driven core jumps between its actions with computed goto where
+// the compiler supports it, and falls back to a switch otherwise.
+#ifndef RJSON_COMPUTED_GOTO
+#if defined(__GNUC__) || defined(__clang__)
+#define RJSON_COMPUTED_GOTO 1
+#else
+#define RJSON_COMPUTED_GOTO 0
+#endif
+#endif
 
 // --- Serialization Helpers (Internal) ---
 
@@ -60,24 +93,256 @@ static void strbuf_free(struct strbuf *sb)
     free(sb->buffer);
 }
 
+/* An open container while a tree is written out, and its next child */
+struct walk_frame
+{
+    const rjson_value *container;
+    size_t next;
+};
+
+/*
+ * The open containers of a tree walk (serialization, printing), innermost
+ * last. Shallow trees use the frames inside the struct; deeper ones move
+ * to the heap, so the C stack does not bound the depth.
+ */
+struct walk_stack
+{
+    struct walk_frame *frames;
+    size_t depth;
+    size_t cap;
+    struct walk_frame local[32];
+};
+
+static void walk_init(struct walk_stack *st)
+{
+    st->frames = st->local;
+    st->depth = 0;
+    st->cap = sizeof(st->local) / sizeof(st->local[0]);
+}
+
+/* Opens `container`, starting at its first child */
+static int walk_push(struct walk_stack *st, const rjson_value *container)
+{
+    if (st->depth == st->cap)
+    {
+        size_t cap = st->cap * 2;
+        struct walk_frame *grown = (struct walk_frame *)malloc(cap * sizeof(struct walk_frame));
+        if (!grown)
+            return -1;
+        memcpy(grown, st->frames, st->depth * sizeof(struct walk_frame));
+        if (st->frames != st->local)
+            free(st->frames);
+        st->frames = grown;
+        st->cap = cap;
+    }
+    st->frames[st->depth].container = container;
+    st->frames[st->depth].next = 0;
+    st->depth++;
+    return 0;
+}
+
+static void walk_release(struct walk_stack *st)
+{
+    if (st->frames != st->local)
+        free(st->frames);
+}
+
+/* Number of elements or members of a container */
+static size_t walk_child_count(const rjson_value *container)
+{
+    return container->type == RJSON_ARRAY ? container->as.arr_val.count : container->as.obj_val.count;
+}
+
+/* Element `i` of an array, or the value of member `i` of an object */
+static const rjson_value *walk_child(const rjson_value *container, size_t i)
+{
+    return container->type == RJSON_ARRAY ? container->as.arr_val.elements[i] : container->as.obj_val.values[i];
+}
+
+// --- Parser State ---
+
+/* An object key read by the parser */
+struct member_key
+{
+    char *str;  // NUL-terminated; NULL in arrays and at the top level
+    size_t len; // Length in bytes
+};
+
+/* An open container on the parser's explicit stack */
+struct parser_frame
+{
+    rjson_value *container;
+    struct member_key key; // Its key in the enclosing object
+    size_t first;          // Index of its first child in the pending list
+};
+
+/* A slot of the key interning table; `key` is NULL when free */
+struct key_slot
+{
+    char *key;
+    size_t len;
+    uint64_t hash;
+};
+
+/* Distinct keys of one document (RJSON_PARSE_INTERN_KEYS), open addressing */
+struct key_table
+{
+    struct key_slot *slots;
+    size_t capacity; // A power of two, at most half full
+    size_t count;
+};
+
+/*
+ * State shared by the recursive-descent parser. The input is the byte range
+ * [cur, end) and does not need to be NUL-terminated.
+ * When `arena` is set every node and string is bump-allocated from it.
+ * When `insitu` is set strings are decoded into the input buffer itself.
+ */
+struct parser
+{
+    const char *cur;
+    const char *end;    // One past the last input byte; scanning never reads beyond it
+    unsigned int flags; // RJSON_PARSE_* options
+    rjson_arena *arena;
+    int insitu;         // Decode strings in place; the input buffer is writable
+    int intern;         // Share one copy of each distinct key (see struct key_table)
+    struct key_table keys;
+    // Structural index (NULL when scanning byte by byte). `next` is the first
+    // entry not behind the cursor; offsets are relative to `base`.
+    const char *base;
+    const uint32_t *next;
+    // Decode buffer for escaped strings, reused across the whole document
+    char *scratch;
+    size_t scratch_cap;
+    // Open containers, innermost last
+    struct parser_frame *stack;
+    size_t depth;
+    size_t stack_cap;
+    size_t max_depth;
+    // Completed children of the open containers, in document order. A
+    // container's own storage is allocated once, at its exact size, when it
+    // closes and its children are moved off this list.
+    rjson_value **pending;
+    struct member_key *pending_keys; // Parallel to `pending`; no key for array elements
+    size_t pending_count;
+    size_t pending_cap;
+};
+
+// --- Object Key Storage ---
+
+/*
+ * Hash index of the keys of an object with at least RJSON_OBJECT_INDEX_MIN
+ * members (rjson_object.index), allocated as one block: an open-addressing
+ * table of member numbers. Members stay in insertion order in `keys` and
+ * `values`. The table only proposes candidates: lookups check each against
+ * the key itself, and scan the members after a miss, so keys replaced by
+ * hand are still found.
+ */
+struct rjson_object_index
+{
+    size_t count;      // Members entered, a prefix of the object's
+    size_t capacity;   // Members that fit without rebuilding
+    size_t slot_count; // A power of two
+    uint32_t slots[];  // Member number + 1 (0 for a free slot); at most half full
+};
+
+/* Table size for an index of `capacity` members, 0 if it should have none */
+static size_t object_index_slots(size_t capacity)
+{
+    if (capacity < RJSON_OBJECT_INDEX_MIN || capacity > UINT32_MAX / 4)
+        return 0; // Scanning a few keys is faster than hashing one
+    size_t slot_count = 32;
+    while (slot_count < capacity * 2)
+        slot_count *= 2;
+    return slot_count;
+}
+
+/* Bytes of the block holding an index */
+static size_t object_index_size(size_t slot_count)
+{
+    return sizeof(struct rjson_object_index) + slot_count * sizeof(uint32_t);
+}
+
+/* Lays out an empty index in `block` (object_index_size() bytes) */
+static struct rjson_object_index *object_index_init(void *block, size_t capacity, size_t slot_count)
+{
+    struct rjson_object_index *index = (struct rjson_object_index *)block;
+    index->count = 0;
+    index->capacity = capacity;
+    index->slot_count = slot_count;
+    memset(index->slots, 0, slot_count * sizeof(uint32_t));
+    return index;
+}
+
+/*
+ * Whether key `i` is exactly the `len` bytes at `key`, which contain no NUL.
+ * Key lengths are not stored, so keys replaced by hand are always measured
+ * right; interned keys usually match by address.
+ */
+static int object_key_equals(const rjson_object *obj, size_t i, const char *key, size_t len)
+{
+    const char *k = obj->keys[i];
+    return (k == key || strncmp(k, key, len) == 0) && k[len] == '\0';
+}
+
+/* FNV-1a hash of a key */
+static uint64_t key_hash(const char *s, size_t len)
+{
+    uint64_t h = UINT64_C(14695981039346656037);
+    for (size_t i = 0; i < len; i++)
+        h = (h ^ (unsigned char)s[i]) * UINT64_C(1099511628211);
+    return h;
+}
+
+/*
+ * Enters the object's next member, `index->count`, in its hash index.
+ * Members are entered in order, so of duplicate keys the first is found
+ * first, as by a linear scan.
+ */
+static void object_index_insert(struct rjson_object_index *index, const rjson_object *obj)
+{
+    size_t i = index->count++;
+    size_t mask = index->slot_count - 1;
+    size_t h = (size_t)key_hash(obj->keys[i], strlen(obj->keys[i])) & mask;
+    while (index->slots[h])
+        h = (h + 1) & mask;
+    index->slots[h] = (uint32_t)(i + 1);
+}
+
 // --- Forward Declarations for Static Functions ---
 
 // Parsing
-static rjson_value *parse_value(const char **json, int depth);
-static rjson_value *parse_string(const char **json);
-static rjson_value *parse_number(const char **json);
-static rjson_value *parse_literal(const char **json);
-static rjson_value *parse_array(const char **json, int depth);
-static rjson_value *parse_object(const char **json, int depth);
-static void skip_whitespace(const char **json);
-static char *unescape_string(const char *in_start, const char *in_end, size_t *out_len);
+static rjson_value *parse_value(struct parser *p);
+static rjson_value *parse_string(struct parser *p);
+static rjson_value *parse_number(struct parser *p);
+static rjson_value *parse_literal(struct parser *p);
+static void skip_whitespace(struct parser *p);
+static int parse_key(struct parser *p, struct member_key *key);
 
 // Serialization
-static int serialize_value(const rjson_value *value, struct strbuf *sb, int depth);
-static int escape_string(const char *in, struct strbuf *sb);
+static int serialize_value(const rjson_value *value, struct strbuf *sb);
+static int escape_string(const char *in, size_t in_len, struct strbuf *sb);
 
 // --- Memory Management Helpers ---
 
+/*
+ * A heap key shared by the objects of one document (RJSON_PARSE_INTERN_KEYS).
+ * Objects hold `text`; the key is freed when its last object is.
+ */
+struct interned_key
+{
+    size_t refs;
+    char text[];
+};
+
+/* Drops one object's reference to an interned heap key */
+static void key_unref(char *key)
+{
+    struct interned_key *ik = (struct interned_key *)(key - offsetof(struct interned_key, text));
+    if (--ik->refs == 0)
+        free(ik);
+}
+
 static rjson_value *create_value(rjson_type type)
 {
     rjson_value *val = (rjson_value *)calloc(1, sizeof(rjson_value));
@@ -108,19 +373,70 @@ rjson_value *rjson_number_new(double num_val)
     return val;
 }
 
+rjson_value *rjson_int64_new(int64_t int_val)
+{
+    rjson_value *val = create_value(RJSON_NUMBER);
+    if (!val)
+        return NULL;
+    val->flags |= RJSON_VALUE_INT64;
+    val->as.num_val = (double)int_val;
+    val->as.int_val = int_val;
+    return val;
+}
+
+rjson_value *rjson_uint64_new(uint64_t uint_val)
+{
+    rjson_value *val = create_value(RJSON_NUMBER);
+    if (!val)
+        return NULL;
+    val->flags |= RJSON_VALUE_UINT64;
+    val->as.num_val = (double)uint_val;
+    val->as.uint_val = uint_val;
+    return val;
+}
+
+/* Stores a short string (at most RJSON_INLINE_STRING_MAX bytes) inside its node */
+static void string_set_inline(rjson_value *val, const char *s, size_t len)
+{
+    memcpy(val->as.str_inline, s, len);
+    val->as.str_inline[len] = '\0';
+    val->as.str_val = NULL; // No pointer into the node itself: copies stay valid
+    val->as.str_len = len;
+    val->flags |= RJSON_VALUE_INLINE;
+}
+
+/* The bytes of a string node, stored inline or elsewhere */
+static const char *string_bytes(const rjson_value *val)
+{
+    return (val->flags & RJSON_VALUE_INLINE) ? val->as.str_inline : val->as.str_val;
+}
+
 rjson_value *rjson_string_new(const char *str_val)
 {
+    return rjson_string_new_n(str_val, strlen(str_val));
+}
+
+rjson_value *rjson_string_new_n(const char *str_val, size_t len)
+{
+    if (!str_val)
+    {
+        if (len > 0)
+            return NULL;
+        str_val = "";
+    }
     rjson_value *val = create_value(RJSON_STRING);
     if (!val)
         return NULL;
 
-    val->as.str_val = (char *)malloc(strlen(str_val) + 1);
+    val->as.str_val = (char *)malloc(len + 1);
     if (!val->as.str_val)
     {
         free(val);
         return NULL;
     }
-    strcpy(val->as.str_val, str_val);
+    memcpy(val->as.str_val, str_val, len);
+    val->as.str_val[len] = '\0';
+    val->as.str_len = len;
     return val;
 }
 
@@ -138,708 +454,2749 @@ rjson_value *rjson_object_new(void)
     return val;
 }
 
-// --- Parsing Helper Functions ---
+// --- Parser Allocation Helpers ---
 
-// Skips any whitespace characters in the input string.
-static void skip_whitespace(const char **json)
+/* Allocates raw parser memory from the arena or the heap */
+static void *parser_alloc(struct parser *p, size_t size)
 {
-    // Harden: Only skip RFC 8259 allowed whitespace (Space, Tab, LF, CR).
-    // isspace() in C includes \v and \f, which are invalid in JSON.
-    while (**json == ' ' || **json == '\t' || **json == '\n' || **json == '\r')
-    {
-        (*json)++;
-    }
+    if (p->arena)
+        return rjson__arena_alloc(p->arena, size);
+    return malloc(size);
 }
 
-/**
- * @brief Processes an escaped string segment.
- * Allocates and returns a new string, setting out_len.
- * Does NOT handle \uXXXX unicode escapes.
+/*
+ * Releases a parsed string on an error path. Arena memory is reclaimed on
+ * reset and in-situ strings live in the caller's buffer.
  */
-static char *unescape_string(const char *in_start, const char *in_end, size_t *out_len)
+static void parser_release(struct parser *p, char *str)
 {
-    // Allocation strategy: Unescaping never expands the byte length of the string
-    // (e.g., "\u0041" is 6 bytes -> "A" is 1 byte).
-    // So allocating (in_end - in_start + 1) is always safe.
-    size_t max_len = (size_t)(in_end - in_start);
-    char *out = (char *)malloc(max_len + 1);
-    if (!out)
-        return NULL;
+    if (!p->arena && !p->insitu)
+        free(str);
+}
+
+/* Releases a key from parse_key() on an error path (NULL is ignored) */
+static void parser_release_key(struct parser *p, char *key)
+{
+    if (p->intern && !p->arena && key)
+        key_unref(key);
+    else
+        parser_release(p, key);
+}
 
-    char *d = out;
-    for (const char *p = in_start; p < in_end; p++)
+/*
+ * Creates a zeroed node owned by the arena or the heap. In-situ strings and
+ * objects are marked as borrowing their string data from the input buffer.
+ */
+static rjson_value *parser_new_value(struct parser *p, rjson_type type)
+{
+    rjson_value *val;
+    if (p->arena)
     {
-        if (*p == '\\')
-        {
-            p++;
-            if (p >= in_end)
-            {
-                free(out);
-                return NULL;
-            } // Safety check
+        val = (rjson_value *)rjson__arena_alloc(p->arena, sizeof(rjson_value));
+        if (!val)
+            return NULL;
+        memset(val, 0, sizeof(rjson_value));
+        val->type = type;
+        val->flags = RJSON_VALUE_ARENA;
+    }
+    else
+    {
+        val = create_value(type);
+        if (!val)
+            return NULL;
+    }
 
-            switch (*p)
-            {
-            case '"':
-                *d++ = '"';
-                break;
-            case '\\':
-                *d++ = '\\';
-                break;
-            case '/':
-                *d++ = '/';
-                break;
-            case 'b':
-                *d++ = '\b';
-                break;
-            case 'f':
-                *d++ = '\f';
-                break;
-            case 'n':
-                *d++ = '\n';
-                break;
-            case 'r':
-                *d++ = '\r';
-                break;
-            case 't':
-                *d++ = '\t';
-                break;
-            case 'u':
-            {
-                // Harden: Implement \uXXXX decoding to UTF-8
-                uint32_t cp = 0;
-                // Need at least 4 hex digits
-                if (in_end - p < 5)
-                {
-                    free(out);
-                    return NULL;
-                }
+    if (p->insitu && (type == RJSON_STRING || type == RJSON_OBJECT))
+        val->flags |= RJSON_VALUE_BORROWED;
+    if (p->intern && type == RJSON_OBJECT)
+        val->flags |= RJSON_VALUE_INTERNED;
+    return val;
+}
 
-                for (int i = 0; i < 4; i++)
-                {
-                    char c = *(++p);
-                    int v = -1;
-                    if (c >= '0' && c <= '9')
-                        v = c - '0';
-                    else if (c >= 'a' && c <= 'f')
-                        v = c - 'a' + 10;
-                    else if (c >= 'A' && c <= 'F')
-                        v = c - 'A' + 10;
-                    if (v < 0)
-                    {
-                        free(out);
-                        return NULL;
-                    } // Invalid hex
-                    cp = (cp << 4) | v;
-                }
+// --- Parsing Helper Functions ---
 
-                // Handle UTF-16 surrogate pairs (e.g. emojis)
-                if (cp >= 0xD800 && cp <= 0xDBFF)
-                {
-                    // Check for following low surrogate \uXXXX
-                    if (in_end - p >= 7 && p[1] == '\\' && p[2] == 'u')
-                    {
-                        uint32_t low = 0;
-                        const char *low_p = p + 2;
-                        int valid_low = 1;
-                        for (int i = 0; i < 4; i++)
-                        {
-                            char c = *(++low_p);
-                            int v = -1;
-                            if (c >= '0' && c <= '9')
-                                v = c - '0';
-                            else if (c >= 'a' && c <= 'f')
-                                v = c - 'a' + 10;
-                            else if (c >= 'A' && c <= 'F')
-                                v = c - 'A' + 10;
-                            if (v < 0)
-                            {
-                                valid_low = 0;
-                                break;
-                            }
-                            low = (low << 4) | v;
-                        }
-                        if (valid_low && low >= 0xDC00 && low <= 0xDFFF)
-                        {
-                            cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
-                            p += 6; // Advance past the second \uXXXX
-                        }
-                    }
-                }
+// Returns the current input byte, or '\0' at the end of the input.
+// '\0' is never valid where a token is expected, so it doubles as the end marker.
+static char peek_char(const struct parser *p)
+{
+    return p->cur < p->end ? *p->cur : '\0';
+}
 
-                // Harden: Reject lone surrogates (invalid UTF-8) and null bytes (unsafe for C strings)
-                if ((cp >= 0xD800 && cp <= 0xDFFF) || cp == 0)
-                {
-                    free(out);
-                    return NULL;
-                }
+/*
+ * Byte classes for token dispatch, so the parser never calls <ctype.h>.
+ * The delimiters a number or literal may be followed by come first.
+ */
+enum char_class
+{
+    CC_OTHER = 0, // Never starts a token
+    CC_SPACE,
+    CC_QUOTE,
+    CC_COMMA,
+    CC_COLON,
+    CC_OPEN_ARRAY,
+    CC_CLOSE_ARRAY,
+    CC_OPEN_OBJECT,
+    CC_CLOSE_OBJECT,
+    CC_NUMBER,  // '-' and digits
+    CC_LITERAL, // 't', 'f' and 'n'
+    CC_COUNT
+};
 
-                // Encode to UTF-8
-                if (cp < 0x80)
-                {
-                    *d++ = (char)cp;
-                }
-                else if (cp < 0x800)
-                {
-                    *d++ = (char)(0xC0 | (cp >> 6));
-                    *d++ = (char)(0x80 | (cp & 0x3F));
-                }
-                else if (cp < 0x10000)
-                {
-                    *d++ = (char)(0xE0 | (cp >> 12));
-                    *d++ = (char)(0x80 | ((cp >> 6) & 0x3F));
-                    *d++ = (char)(0x80 | (cp & 0x3F));
-                }
-                else
-                {
-                    *d++ = (char)(0xF0 | (cp >> 18));
-                    *d++ = (char)(0x80 | ((cp >> 12) & 0x3F));
-                    *d++ = (char)(0x80 | ((cp >> 6) & 0x3F));
-                    *d++ = (char)(0x80 | (cp & 0x3F));
-                }
-                break;
-            }
-            default:
-                // Harden: Fail on invalid escapes
-                free(out);
-                return NULL;
-            }
-        }
-        else
-        {
-            *d++ = *p;
-        }
-    }
+static const uint8_t char_class[256] = {
+    [' '] = CC_SPACE, ['\t'] = CC_SPACE, ['\n'] = CC_SPACE, ['\r'] = CC_SPACE,
+    ['"'] = CC_QUOTE, [','] = CC_COMMA, [':'] = CC_COLON,
+    ['['] = CC_OPEN_ARRAY, [']'] = CC_CLOSE_ARRAY, ['{'] = CC_OPEN_OBJECT, ['}'] = CC_CLOSE_OBJECT,
+    ['-'] = CC_NUMBER, ['0'] = CC_NUMBER, ['1'] = CC_NUMBER, ['2'] = CC_NUMBER, ['3'] = CC_NUMBER,
+    ['4'] = CC_NUMBER, ['5'] = CC_NUMBER, ['6'] = CC_NUMBER, ['7'] = CC_NUMBER, ['8'] = CC_NUMBER,
+    ['9'] = CC_NUMBER, ['t'] = CC_LITERAL, ['f'] = CC_LITERAL, ['n'] = CC_LITERAL,
+};
 
-    *d = '\0';
-    *out_len = (size_t)(d - out);
-    return out;
+/* Class of the byte at the cursor; the end of the input is CC_OTHER */
+static enum char_class peek_class(const struct parser *p)
+{
+    return (enum char_class)char_class[(unsigned char)peek_char(p)];
 }
 
-// Parses a JSON string literal.
-static rjson_value *parse_string(const char **json)
+// Skips any whitespace characters in the input string.
+static void skip_whitespace(struct parser *p)
 {
-    (*json)++; // Skip opening quote
-    const char *start = *json;
-
-    // Find the end of the string, watching for escapes
-    while (**json != '"' && **json != '\0')
+    // With an index, the next token starts at the next structural position.
+    // Every byte between the cursor and it is whitespace: scalars are checked
+    // for a delimiter and strings end right before the following structural.
+    if (p->next)
     {
-        if ((unsigned char)**json < 0x20)
-            return NULL; // Harden: Reject unescaped control chars
-        if (**json == '\\')
-        {
-            (*json)++;
-            if (**json == '\0')
-                return NULL; // Unterminated escape
-        }
-        (*json)++;
+        const uint32_t *next = p->next;
+        while (p->base + *next < p->cur) // The sentinel (end of input) stops the scan
+            next++;
+        p->next = next;
+        p->cur = p->base + *next;
+        return;
     }
 
-    if (**json != '"')
+    // Harden: Only skip RFC 8259 allowed whitespace (Space, Tab, LF, CR).
+    // isspace() in C includes \v and \f, which are invalid in JSON.
+    while (p->cur < p->end && (*p->cur == ' ' || *p->cur == '\t' || *p->cur == '\n' || *p->cur == '\r'))
     {
-        return NULL; // Unterminated string
+        p->cur++;
     }
+}
 
-    const char *end = *json;
-    (*json)++; // Skip closing quote
+// Returns how many bytes may be read at the cursor. Padded input guarantees
+// RJSON_PADDING readable bytes past the end, so vector loads need no tail.
+static size_t readable_bytes(const struct parser *p)
+{
+    size_t n = (size_t)(p->end - p->cur);
+    return (p->flags & RJSON_PARSE_PADDED) ? n + RJSON_PADDING : n;
+}
 
-    size_t unescaped_len = 0;
-    char *str_content = unescape_string(start, end, &unescaped_len);
-    if (!str_content)
-        return NULL;
+// Decoded byte for each single-character escape (\" \\ \/ \b \f \n \r \t);
+// 0 for bytes that may not follow a backslash. \u is handled separately.
+static const char escape_value[256] = {
+    ['"'] = '"',
+    ['\\'] = '\\',
+    ['/'] = '/',
+    ['b'] = '\b',
+    ['f'] = '\f',
+    ['n'] = '\n',
+    ['r'] = '\r',
+    ['t'] = '\t',
+};
 
-    rjson_value *val = create_value(RJSON_STRING);
-    if (!val)
-    {
-        free(str_content);
-        return NULL;
-    }
-    val->as.str_val = str_content;
-    return val;
-}
+// Value of each hex digit, -1 for any other byte
+static const int8_t hex_value[256] = {
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+     0,  1,  2,  3,  4,  5,  6,  7,  8,  9, -1, -1, -1, -1, -1, -1,
+    -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+};
 
-/**
- * @brief Parses a JSON number in a locale-independent way.
- * This avoids the locale-dependent decimal separator bug from strtod().
- */
-static rjson_value *parse_number(const char **json)
+/* Decodes the four hex digits at `s`, or returns -1 if any of them is not hex */
+static int32_t decode_hex4(const char *s)
 {
-    const char *start = *json;
-
-    // Check for negative sign
-    if (**json == '-')
-        (*json)++;
+    const unsigned char *u = (const unsigned char *)s;
+    int32_t d0 = hex_value[u[0]], d1 = hex_value[u[1]], d2 = hex_value[u[2]], d3 = hex_value[u[3]];
+    if ((d0 | d1 | d2 | d3) < 0)
+        return -1;
+    return (d0 << 12) | (d1 << 8) | (d2 << 4) | d3;
+}
 
-    // Check for integer part
-    if (**json == '0')
+/* Writes `cp` as UTF-8 (1 to 4 bytes) and returns the position after it */
+static char *encode_utf8(char *d, uint32_t cp)
+{
+    if (cp < 0x80)
+    {
+        *d++ = (char)cp;
+    }
+    else if (cp < 0x800)
     {
-        (*json)++;
-        if (isdigit((unsigned char)**json))
-            return NULL; // Harden: Leading zero not allowed (e.g. 01)
+        *d++ = (char)(0xC0 | (cp >> 6));
+        *d++ = (char)(0x80 | (cp & 0x3F));
     }
-    else if (isdigit((unsigned char)**json))
+    else if (cp < 0x10000)
     {
-        while (isdigit((unsigned char)**json))
-            (*json)++;
+        *d++ = (char)(0xE0 | (cp >> 12));
+        *d++ = (char)(0x80 | ((cp >> 6) & 0x3F));
+        *d++ = (char)(0x80 | (cp & 0x3F));
     }
     else
     {
-        return NULL; // Invalid: "e.g., -e10" or just "-"
+        *d++ = (char)(0xF0 | (cp >> 18));
+        *d++ = (char)(0x80 | ((cp >> 12) & 0x3F));
+        *d++ = (char)(0x80 | ((cp >> 6) & 0x3F));
+        *d++ = (char)(0x80 | (cp & 0x3F));
     }
+    return d;
+}
+
+/*
+ * Decodes the escape sequence at the cursor (which is on the backslash) into
+ * `d`, writing at most 4 bytes, and moves the cursor past it. \uXXXX escapes,
+ * including surrogate pairs, are decoded to UTF-8.
+ * Returns the new output position, or NULL for an invalid escape.
+ */
+static char *decode_escape(struct parser *p, char *d)
+{
+    const char *s = p->cur;
+    if (p->end - s < 2)
+        return NULL; // Unterminated escape
 
-    // Check for fractional part
-    if (**json == '.')
+    if (s[1] != 'u')
     {
-        (*json)++;
-        // After '.', must have at least one digit
-        if (!isdigit((unsigned char)**json))
-        {
-            return NULL; // Invalid: "e.g., 1."
-        }
-        while (isdigit((unsigned char)**json))
-            (*json)++;
+        char c = escape_value[(unsigned char)s[1]];
+        if (!c)
+            return NULL; // Harden: Fail on invalid escapes
+        *d++ = c;
+        p->cur = s + 2;
+        return d;
     }
 
-    // Check for exponent part
-    if (**json == 'e' || **json == 'E')
-    {
-        (*json)++;
-        // After 'e', can have optional +/-
-        if (**json == '+' || **json == '-')
-            (*json)++;
+    // Harden: Implement \uXXXX decoding to UTF-8. A closing quote is never a
+    // hex digit, so bounding by the end of the input is enough here.
+    if (p->end - s < 6)
+        return NULL;
+    int32_t cp = decode_hex4(s + 2);
+    if (cp < 0)
+        return NULL; // Invalid hex
+    s += 6;
 
-        // After 'e', must have at least one digit
-        if (!isdigit((unsigned char)**json))
+    // Handle UTF-16 surrogate pairs (e.g. emojis)
+    if (cp >= 0xD800 && cp <= 0xDBFF && p->end - s >= 6 && s[0] == '\\' && s[1] == 'u')
+    {
+        int32_t low = decode_hex4(s + 2);
+        if (low >= 0xDC00 && low <= 0xDFFF)
         {
-            return NULL; // Invalid: "e.g., 1e" or "1e+"
+            cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+            s += 6; // Advance past the second \uXXXX
         }
-        while (isdigit((unsigned char)**json))
-            (*json)++;
     }
 
-    // We've found the end of the number. Now we use strtod on our segment.
-    // We *must* use strtod for robust parsing of doubles, but since we've
-    // validated the format, we are safe from the locale *parsing* bug
-    // (e.g. "3.14" won't be parsed as "3").
-    char *end;
-    errno = 0;
-    double num = strtod(start, &end);
+    // Harden: Reject lone surrogates (invalid UTF-8) and, unless the caller
+    // reads strings by length (RJSON_PARSE_ALLOW_NUL), null bytes
+    if ((cp >= 0xD800 && cp <= 0xDFFF) || (cp == 0 && !(p->flags & RJSON_PARSE_ALLOW_NUL)))
+        return NULL;
+
+    p->cur = s;
+    return encode_utf8(d, (uint32_t)cp);
+}
+
+/* Makes room for `need` more bytes after the first `used` of the scratch buffer */
+static int scratch_reserve(struct parser *p, size_t used, size_t need)
+{
+    if (p->scratch_cap - used >= need)
+        return 0;
+    size_t cap = p->scratch_cap ? p->scratch_cap : 256;
+    while (cap - used < need)
+        cap *= 2;
+    char *grown = (char *)realloc(p->scratch, cap);
+    if (!grown)
+        return -1;
+    p->scratch = grown;
+    p->scratch_cap = cap;
+    return 0;
+}
+
+/*
+ * Reads the string literal at the cursor in a single pass, decoding escapes
+ * as they are found, and moves past the closing quote. Plain runs are
+ * located with SIMD and moved wholesale; every input byte is read once.
+ *
+ * Returns the contents and sets *out_len (no terminator is written):
+ *   - escape-free strings: the source bytes themselves (*escaped = 0)
+ *   - otherwise: decoded in place for in-situ parsing, else in the parser's
+ *     scratch buffer, valid until the next string is read (*escaped = 1)
+ * Returns NULL on malformed input.
+ */
+static const char *read_string(struct parser *p, size_t *out_len, int *escaped)
+{
+    const char *start = ++p->cur; // Skip opening quote
+    *escaped = 0;
+
+    // Skip the run of plain bytes with SIMD; it may end in the padding
+    p->cur += rjson__string_span(p->cur, readable_bytes(p));
+    if (p->cur >= p->end)
+        return NULL; // Unterminated string
+    if (*p->cur == '"')
+    {
+        *out_len = (size_t)(p->cur - start);
+        p->cur++; // Skip closing quote
+        return start;
+    }
 
-    // Check for errors from strtod
-    if (errno == ERANGE || !isfinite(num))
+    // Found an escape (or a bad byte): decode from here on
+    *escaped = 1;
+    size_t used = (size_t)(p->cur - start);
+    char *out = (char *)start;
+    if (!p->insitu)
     {
-        return NULL; // Overflow or invalid number
+        if (scratch_reserve(p, 0, used + 4) != 0)
+            return NULL;
+        out = p->scratch;
+        memcpy(out, start, used);
     }
+    char *d = out + used;
 
-    // The C standard locale is "C", where strtod always uses '.'.
-    // If the *current* locale uses a ',', strtod might stop early.
-    // Our 'end' pointer will be at *json.
-    if (end != *json)
+    while (*p->cur != '"')
     {
-        // This can happen if the locale is "fr_FR" and we parse "3.14".
-        // strtod might stop at the '.', parsing "3".
-        // We must manually rescan.
+        if ((unsigned char)*p->cur < 0x20)
+            return NULL; // Harden: Reject unescaped control chars
 
-        // This is a failsafe: create a temporary NUL-terminated string
-        // to parse in the "C" locale.
-        size_t len = *json - start;
-        char *temp_num = (char *)malloc(len + 1);
-        if (!temp_num)
+        d = decode_escape(p, d);
+        if (!d)
             return NULL;
-        memcpy(temp_num, start, len);
-        temp_num[len] = '\0';
 
-        // This is still locale-dependent, but the manual parse above
-        // is our best defense. The *truly* robust way is to set locale,
-        // but that's not thread-safe.
-        num = strtod(temp_num, &end);
-        free(temp_num);
-
-        if (*end != '\0')
+        size_t run = rjson__string_span(p->cur, readable_bytes(p));
+        if (run >= (size_t)(p->end - p->cur))
+            return NULL; // Unterminated string
+        if (!p->insitu)
         {
-            return NULL; // Failsafe check failed
+            // Room for the run and the escape that may follow it
+            used = (size_t)(d - out);
+            if (scratch_reserve(p, used, run + 4) != 0)
+                return NULL;
+            out = p->scratch;
+            d = out + used;
         }
+        // In place, the output never overtakes the input, but they may overlap
+        memmove(d, p->cur, run);
+        d += run;
+        p->cur += run;
     }
 
-    rjson_value *val = create_value(RJSON_NUMBER);
-    if (!val)
-        return NULL;
-    val->as.num_val = num;
-    return val;
+    *out_len = (size_t)(d - out);
+    p->cur++; // Skip closing quote
+    return out;
 }
 
-// Parses JSON literals: true, false, and null.
-static rjson_value *parse_literal(const char **json)
+/*
+ * Returns a NUL-terminated copy of string contents from read_string(): in
+ * place for in-situ parsing (the terminator lands on or before the closing
+ * quote), otherwise in a fresh arena/heap block.
+ */
+static char *materialize_string(struct parser *p, const char *s, size_t len)
 {
-    if (strncmp(*json, "true", 4) == 0)
-    {
-        *json += 4;
-        rjson_value *val = create_value(RJSON_BOOL);
-        if (val)
-            val->as.bool_val = 1;
-        return val;
-    }
-    if (strncmp(*json, "false", 5) == 0)
-    {
-        *json += 5;
-        rjson_value *val = create_value(RJSON_BOOL);
-        if (val)
-            val->as.bool_val = 0;
-        return val;
-    }
-    if (strncmp(*json, "null", 4) == 0)
+    char *out = p->insitu ? (char *)s : (char *)parser_alloc(p, len + 1);
+    if (!out)
+        return NULL;
+    if (!p->insitu)
+        memcpy(out, s, len);
+    out[len] = '\0';
+    return out;
+}
+
+/* Doubles the interning table (or creates it) and rehashes its keys */
+static int key_table_grow(struct key_table *t)
+{
+    size_t capacity = t->capacity ? t->capacity * 2 : 64;
+    struct key_slot *slots = (struct key_slot *)calloc(capacity, sizeof(struct key_slot));
+    if (!slots)
+        return -1;
+    for (size_t i = 0; i < t->capacity; i++)
     {
-        *json += 4;
-        return create_value(RJSON_NULL);
+        if (!t->slots[i].key)
+            continue;
+        size_t j = (size_t)t->slots[i].hash & (capacity - 1);
+        while (slots[j].key)
+            j = (j + 1) & (capacity - 1);
+        slots[j] = t->slots[i];
     }
-    return NULL; // Invalid literal
+    free(t->slots);
+    t->slots = slots;
+    t->capacity = capacity;
+    return 0;
 }
 
-// Parses a JSON array.
-static rjson_value *parse_array(const char **json, int depth)
+/*
+ * Returns the document's single copy of the key `s` (`len` bytes), storing
+ * it on first sight. Heap keys are reference-counted: each call hands out
+ * one reference. Returns NULL on OOM.
+ */
+static char *intern_key(struct parser *p, const char *s, size_t len)
 {
-    if (depth >= RJSON_MAX_DEPTH)
-        return NULL; // Stack exhaustion protection
-    (*json)++;       // Skip '['
-
-    rjson_value *arr_val = rjson_array_new();
-    if (!arr_val)
+    struct key_table *t = &p->keys;
+    if (t->count * 2 >= t->capacity && key_table_grow(t) != 0)
         return NULL;
 
-    skip_whitespace(json);
-    if (**json == ']')
+    uint64_t hash = key_hash(s, len);
+    size_t mask = t->capacity - 1;
+    size_t i = (size_t)hash & mask;
+    for (; t->slots[i].key; i = (i + 1) & mask)
     {
-        (*json)++; // Empty array
-        return arr_val;
+        struct key_slot *slot = &t->slots[i];
+        if (slot->hash == hash && slot->len == len && memcmp(slot->key, s, len) == 0)
+        {
+            if (!p->arena)
+                ((struct interned_key *)(slot->key - offsetof(struct interned_key, text)))->refs++;
+            return slot->key;
+        }
     }
 
-    while (1)
+    char *key;
+    if (p->arena)
     {
-        rjson_value *element = parse_value(json, depth + 1);
-        if (!element)
-        {
-            rjson_free(arr_val);
+        key = (char *)rjson__arena_alloc(p->arena, len + 1);
+        if (!key)
             return NULL;
-        }
-
-        if (rjson_array_add(arr_val, element) != 0)
-        {
-            rjson_free(element);
-            rjson_free(arr_val);
-            return NULL; // Out of memory
-        }
-
-        skip_whitespace(json);
-
-        if (**json == ']')
-        {
-            (*json)++;
-            break;
-        }
-        if (**json != ',')
-        {
-            rjson_free(arr_val);
-            return NULL; // Expected comma or ']'
-        }
-        (*json)++; // Skip comma
     }
-    return arr_val;
+    else
+    {
+        struct interned_key *ik = (struct interned_key *)malloc(sizeof(struct interned_key) + len + 1);
+        if (!ik)
+            return NULL;
+        ik->refs = 1;
+        key = ik->text;
+    }
+    memcpy(key, s, len);
+    key[len] = '\0';
+    t->slots[i].key = key;
+    t->slots[i].len = len;
+    t->slots[i].hash = hash;
+    t->count++;
+    return key;
 }
 
-// Parses a JSON object.
-static rjson_value *parse_object(const char **json, int depth)
+// Parses an object key into `key`: its unescaped contents, interned if enabled.
+static int parse_key(struct parser *p, struct member_key *key)
 {
-    if (depth >= RJSON_MAX_DEPTH)
-        return NULL; // Stack exhaustion protection
-    (*json)++;       // Skip '{'
+    size_t len;
+    int escaped;
+    const char *s = read_string(p, &len, &escaped);
+    if (!s)
+        return -1;
+    if (escaped && (p->flags & RJSON_PARSE_ALLOW_NUL) && memchr(s, '\0', len))
+        return -1; // Keys are NUL-terminated strings, even when values may contain NUL
+    key->str = p->intern ? intern_key(p, s, len) : materialize_string(p, s, len);
+    key->len = len;
+    return key->str ? 0 : -1;
+}
 
-    rjson_value *obj_val = rjson_object_new();
-    if (!obj_val)
+// Parses a JSON string literal.
+static rjson_value *parse_string(struct parser *p)
+{
+    size_t len = 0;
+    int escaped;
+    const char *s = read_string(p, &len, &escaped);
+    if (!s)
         return NULL;
 
-    skip_whitespace(json);
-    if (**json == '}')
+    // Zero-copy: an escape-free string is exactly its source bytes, so the
+    // node can reference the input instead of copying it.
+    if (!escaped && (p->flags & RJSON_PARSE_ZEROCOPY) && !p->insitu)
     {
-        (*json)++; // Empty object
-        return obj_val;
+        rjson_value *view = parser_new_value(p, RJSON_STRING);
+        if (!view)
+            return NULL;
+        view->flags |= RJSON_VALUE_BORROWED | RJSON_VALUE_VIEW;
+        view->as.str_val = (char *)s;
+        view->as.str_len = len;
+        return view;
     }
 
-    while (1)
+    // Short strings live inside the node: no allocation, same cache line
+    if (len <= RJSON_INLINE_STRING_MAX && (p->flags & RJSON_PARSE_INLINE_STRINGS) && !p->insitu)
     {
-        skip_whitespace(json);
-        if (**json != '"')
-        {
-            rjson_free(obj_val);
-            return NULL; // Key must be a string
-        }
-        rjson_value *key_val = parse_string(json);
-        if (!key_val)
-        {
-            rjson_free(obj_val);
-            return NULL;
-        }
+        rjson_value *val = parser_new_value(p, RJSON_STRING);
+        if (val)
+            string_set_inline(val, s, len);
+        return val;
+    }
 
-        skip_whitespace(json);
-        if (**json != ':')
-        {
-            rjson_free(key_val);
-            rjson_free(obj_val);
-            return NULL; // Expected colon
-        }
-        (*json)++; // Skip colon
+    char *str_content = materialize_string(p, s, len);
+    if (!str_content)
+        return NULL;
 
-        rjson_value *val = parse_value(json, depth + 1);
-        if (!val)
-        {
-            rjson_free(key_val);
-            rjson_free(obj_val);
-            return NULL;
-        }
+    rjson_value *val = parser_new_value(p, RJSON_STRING);
+    if (!val)
+    {
+        parser_release(p, str_content);
+        return NULL;
+    }
+    val->as.str_val = str_content;
+    val->as.str_len = len;
+    return val;
+}
 
-        if (rjson_object_add(obj_val, key_val->as.str_val, val) != 0)
+/**
+ * @brief Decodes a JSON number in a locale-independent way.
+ * Grammar checks and conversion are done by rjson__parse_number(), which
+ * never calls strtod() on the input or allocates. Fills the type, flags and
+ * value of `out` and returns 0, or -1 if the number is invalid.
+ */
+static int read_number(struct parser *p, rjson_value *out)
+{
+    out->type = RJSON_NUMBER;
+    out->flags = 0;
+    if (p->flags & RJSON_PARSE_LAZY_NUMBERS)
+    {
+        int has_exponent;
+        const char *after = rjson__scan_number(p->cur, p->end, &has_exponent);
+        if (!after)
+            return -1;
+        size_t len = (size_t)(after - p->cur);
+        if (!has_exponent && len <= RJSON_LAZY_NUMBER_MAX_LENGTH)
         {
-            rjson_free(key_val);
-            rjson_free(val);
-            rjson_free(obj_val);
-            return NULL; // Out of memory
+            out->flags = RJSON_VALUE_LAZY;
+            out->as.num_text = p->cur;
+            out->as.num_len = len;
+            p->cur = after;
+            return 0;
         }
+    }
 
-        free(key_val->as.str_val); // rjson_object_add made a copy
-        free(key_val);             // Free the key *value*, keep the value
+    struct rjson__number num;
+    const char *after = rjson__parse_number(p->cur, p->end, &num);
+    if (!after)
+        return -1; // Malformed or overflows a double
+    p->cur = after;
+
+    out->as.num_val = num.num_val;
+    out->as.uint_val = num.int_bits;
+    if (num.kind == RJSON_NUMBER_INT64)
+        out->flags = RJSON_VALUE_INT64;
+    else if (num.kind == RJSON_NUMBER_UINT64)
+        out->flags = RJSON_VALUE_UINT64;
+    return 0;
+}
 
-        skip_whitespace(json);
+// Parses a JSON number.
+static rjson_value *parse_number(struct parser *p)
+{
+    rjson_value num;
+    if (read_number(p, &num) != 0)
+        return NULL;
+    rjson_value *val = parser_new_value(p, RJSON_NUMBER);
+    if (!val)
+        return NULL;
+    val->flags |= num.flags;
+    val->as = num.as;
+    return val;
+}
 
-        if (**json == '}')
-        {
-            (*json)++;
-            break;
-        }
-        if (**json != ',')
-        {
-            rjson_free(obj_val);
-            return NULL; // Expected comma or '}'
-        }
-        (*json)++; // Skip comma
-    }
+/* Returns nonzero if the input at the cursor starts with `lit` */
+static int match_literal(const struct parser *p, const char *lit, size_t len)
+{
+    return (size_t)(p->end - p->cur) >= len && memcmp(p->cur, lit, len) == 0;
+}
 
-    return obj_val;
+/*
+ * With a structural index, a number or literal must be followed by a
+ * delimiter: the index only marks where a scalar starts, so "truex" or "12a"
+ * would otherwise be skipped over as whitespace.
+ */
+static int scalar_ends_cleanly(const struct parser *p)
+{
+    if (!p->next || p->cur == p->end)
+        return 1;
+    enum char_class cls = peek_class(p);
+    return cls >= CC_SPACE && cls <= CC_CLOSE_OBJECT;
 }
 
-// Main dispatcher for parsing any JSON value.
-static rjson_value *parse_value(const char **json, int depth)
+/* Decodes true, false or null into the type and value of `out`. Returns 0 or -1. */
+static int read_literal(struct parser *p, rjson_value *out)
 {
-    skip_whitespace(json);
-    switch (**json)
+    if (match_literal(p, "true", 4))
     {
-    case '"':
-        return parse_string(json);
-    case '[':
-        return parse_array(json, depth);
-    case '{':
-        return parse_object(json, depth);
-    case 't':
-    case 'f':
-    case 'n':
-        return parse_literal(json);
-    default:
-        if (**json == '-' || isdigit((unsigned char)**json))
-        {
-            return parse_number(json);
-        }
+        p->cur += 4;
+        out->type = RJSON_BOOL;
+        out->as.bool_val = 1;
+        return 0;
     }
-    return NULL; // Invalid character
+    if (match_literal(p, "false", 5))
+    {
+        p->cur += 5;
+        out->type = RJSON_BOOL;
+        out->as.bool_val = 0;
+        return 0;
+    }
+    if (match_literal(p, "null", 4))
+    {
+        p->cur += 4;
+        out->type = RJSON_NULL;
+        return 0;
+    }
+    return -1; // Invalid literal
 }
 
-// --- Public API Implementation ---
-
-rjson_value *rjson_parse(const char *json_string)
+// Parses JSON literals: true, false, and null.
+static rjson_value *parse_literal(struct parser *p)
 {
-    if (!json_string)
+    rjson_value lit;
+    if (read_literal(p, &lit) != 0)
         return NULL;
+    rjson_value *val = parser_new_value(p, lit.type);
+    if (val && lit.type == RJSON_BOOL)
+        val->as.bool_val = lit.as.bool_val;
+    return val;
+}
 
-    // Harden: Skip UTF-8 BOM if present (EF BB BF)
-    if (strncmp(json_string, "\xEF\xBB\xBF", 3) == 0)
-        json_string += 3;
-
-    const char *current_pos = json_string;
-    rjson_value *result = parse_value(&current_pos, 0);
-
-    if (!result)
+// Parses a number or literal and checks the byte that follows it.
+static rjson_value *parse_scalar(struct parser *p, rjson_value *(*parse)(struct parser *))
+{
+    rjson_value *val = parse(p);
+    if (val && !scalar_ends_cleanly(p))
     {
-        // Library should not log, just fail.
+        rjson_free(val);
         return NULL;
     }
+    return val;
+}
 
-    skip_whitespace(&current_pos);
-    if (*current_pos != '\0')
+/*
+ * Attaches a completed value to the innermost open container (under `*key`
+ * for objects) by appending it to the pending list; the container takes it
+ * over when it closes. Consumes the key, and the value on failure.
+ */
+static int attach_value(struct parser *p, rjson_value *value, struct member_key *key)
+{
+    if (p->pending_count == p->pending_cap)
     {
-        // Library should not log. Fail due to extra characters.
-        rjson_free(result);
-        return NULL;
+        size_t cap = p->pending_cap ? p->pending_cap * 2 : 64;
+        rjson_value **values = (rjson_value **)realloc(p->pending, cap * sizeof(rjson_value *));
+        if (values)
+            p->pending = values;
+        struct member_key *keys =
+            values ? (struct member_key *)realloc(p->pending_keys, cap * sizeof(struct member_key)) : NULL;
+        if (!keys)
+        {
+            parser_release_key(p, key->str);
+            key->str = NULL;
+            rjson_free(value); // Out of memory
+            return -1;
+        }
+        p->pending_keys = keys;
+        p->pending_cap = cap;
     }
-
-    return result;
+    p->pending_keys[p->pending_count] = *key;
+    p->pending[p->pending_count++] = value;
+    key->str = NULL;
+    return 0;
 }
 
-void rjson_free(rjson_value *value)
+/*
+ * Moves the pending children from index `first` on into `container`, in
+ * storage allocated once at exactly their number. Returns 0, or -1 on OOM
+ * (the children stay pending and the container empty).
+ */
+static int container_fill(struct parser *p, rjson_value *container, size_t first)
 {
-    if (!value)
-        return;
+    size_t count = p->pending_count - first;
+    if (count == 0)
+        return 0; // Empty containers own no storage, as after rjson_array_new()
 
-    size_t i;
-    switch (value->type)
+    rjson_value **values = (rjson_value **)parser_alloc(p, count * sizeof(rjson_value *));
+    if (!values)
+        return -1;
+    memcpy(values, p->pending + first, count * sizeof(rjson_value *));
+    if (container->type == RJSON_ARRAY)
     {
-    case RJSON_STRING:
-        free(value->as.str_val);
-        break;
-    case RJSON_ARRAY:
-        for (i = 0; i < value->as.arr_val.count; ++i)
-        {
-            rjson_free(value->as.arr_val.elements[i]);
-        }
-        free(value->as.arr_val.elements);
-        break;
-    case RJSON_OBJECT:
-        for (i = 0; i < value->as.obj_val.count; ++i)
+        container->as.arr_val.elements = values;
+        container->as.arr_val.count = count;
+    }
+    else
+    {
+        char **keys = (char **)parser_alloc(p, count * sizeof(char *));
+        if (!keys)
         {
-            free(value->as.obj_val.keys[i]);
-            rjson_free(value->as.obj_val.values[i]);
+            if (!p->arena)
+                free(values);
+            return -1;
         }
-        free(value->as.obj_val.keys);
-        free(value->as.obj_val.values);
-        break;
-    default:
-        // No dynamic memory for NULL, BOOL, NUMBER
-        break;
+        container->as.obj_val.keys = keys;
+        container->as.obj_val.values = values;
+        container->as.obj_val.count = count;
+        for (size_t i = 0; i < count; i++)
+            keys[i] = p->pending_keys[first + i].str;
     }
-    free(value);
+    p->pending_count = first;
+    return 0;
 }
 
-rjson_value *rjson_object_get_value(const rjson_value *object, const char *key)
+/*
+ * Gives a complete parsed object its hash index if it is wide enough. Best
+ * effort: without one (out of memory), lookups scan its keys.
+ */
+static void parser_index_object(struct parser *p, rjson_object *obj)
+{
+    size_t slot_count = object_index_slots(obj->count);
+    void *block = slot_count ? parser_alloc(p, object_index_size(slot_count)) : NULL;
+    if (!block)
+        return;
+    struct rjson_object_index *index = object_index_init(block, obj->count, slot_count);
+    while (index->count < obj->count)
+        object_index_insert(index, obj);
+    obj->index = index;
+}
+
+/*
+ * Opens a container: pushes it on the explicit stack together with its key
+ * (consumed) in the enclosing object. It is attached to its parent only
+ * once it is complete, see close_container().
+ */
+static int open_container(struct parser *p, rjson_value *container, struct member_key key)
 {
-    if (!object || object->type != RJSON_OBJECT || !key)
+    if (p->depth >= p->max_depth)
     {
-        return NULL;
+        parser_release_key(p, key.str);
+        rjson_free(container);
+        return -1; // Depth limit
     }
-
-    for (size_t i = 0; i < object->as.obj_val.count; ++i)
+    if (p->depth == p->stack_cap)
     {
-        if (strcmp(object->as.obj_val.keys[i], key) == 0)
+        size_t cap = p->stack_cap ? p->stack_cap * 2 : 32;
+        struct parser_frame *grown = (struct parser_frame *)realloc(p->stack, cap * sizeof(struct parser_frame));
+        if (!grown)
         {
-            return object->as.obj_val.values[i];
+            parser_release_key(p, key.str);
+            rjson_free(container);
+            return -1;
         }
+        p->stack = grown;
+        p->stack_cap = cap;
     }
+    struct parser_frame *frame = &p->stack[p->depth++];
+    frame->container = container;
+    frame->key = key;
+    frame->first = p->pending_count;
+    return 0;
+}
 
-    return NULL; // Key not found
+/*
+ * Closes the innermost open container: gives it its children and attaches
+ * it to the enclosing container, if any. Returns the container, or NULL on
+ * OOM (release the rest with parser_unwind()).
+ */
+static rjson_value *close_container(struct parser *p)
+{
+    struct parser_frame *frame = &p->stack[p->depth - 1];
+    if (container_fill(p, frame->container, frame->first) != 0)
+        return NULL; // Still open: parser_unwind() releases it
+    p->depth--;
+    rjson_value *container = frame->container;
+    if (container->type == RJSON_OBJECT)
+        parser_index_object(p, &container->as.obj_val);
+    if (p->depth > 0 && attach_value(p, container, &frame->key) != 0)
+        return NULL;
+    return container;
 }
 
-/**
- * @brief Adds an element to a JSON array.
- * This is "rock solid" - if realloc fails, it frees the new element
- * and leaves the original array unmodified.
- *
- * @param array The array object to add to.
- * @param element The element to add.
- * @return 0 on success, -1 on failure (out of memory).
+/*
+ * Releases everything a failed parse still owns: the pending children and
+ * the open containers, with their keys. Nodes returned earlier are not
+ * affected.
  */
-int rjson_array_add(rjson_value *array, rjson_value *element)
+static void parser_unwind(struct parser *p)
 {
-    if (!array || array->type != RJSON_ARRAY || !element)
+    while (p->pending_count > 0)
     {
-        return -1;
+        p->pending_count--;
+        parser_release_key(p, p->pending_keys[p->pending_count].str);
+        rjson_free(p->pending[p->pending_count]);
     }
-
-    size_t new_count = array->as.arr_val.count + 1;
-    rjson_value **new_elements = (rjson_value **)realloc(array->as.arr_val.elements, new_count * sizeof(rjson_value *));
-
-    if (!new_elements)
+    while (p->depth > 0)
     {
-        return -1; // Out of memory
+        p->depth--;
+        parser_release_key(p, p->stack[p->depth].key.str);
+        rjson_free(p->stack[p->depth].container);
     }
+}
 
-    array->as.arr_val.elements = new_elements;
-    array->as.arr_val.elements[new_count - 1] = element;
-    array->as.arr_val.count = new_count;
+/* Parser states of the table-driven and push parsers: what the grammar allows next */
+enum parse_state
+{
+    ST_VALUE,         // A value (top level, after ':' or after ',' in an array)
+    ST_FIRST_ELEMENT, // A value or ']' right after '['
+    ST_FIRST_MEMBER,  // A key or '}' right after '{'
+    ST_MEMBER,        // A key after ',' in an object
+    ST_COLON,         // ':' after a key
+    ST_AFTER_ELEMENT, // ',' or ']' after an array element
+    ST_AFTER_MEMBER,  // ',' or '}' after an object member
+    ST_COUNT
+};
 
-    return 0;
+/* Parser actions; A_FAIL (0) fills every unlisted transition */
+enum parse_action
+{
+    A_FAIL = 0,
+    A_STRING,
+    A_NUMBER,
+    A_LITERAL,
+    A_OPEN_ARRAY,
+    A_OPEN_OBJECT,
+    A_CLOSE,
+    A_KEY,
+    A_COLON,
+    A_NEXT_ELEMENT,
+    A_NEXT_MEMBER,
+    A_COUNT
+};
+
+#define VALUE_ACTIONS                                                                   \
+    [CC_QUOTE] = A_STRING, [CC_NUMBER] = A_NUMBER, [CC_LITERAL] = A_LITERAL,            \
+    [CC_OPEN_ARRAY] = A_OPEN_ARRAY, [CC_OPEN_OBJECT] = A_OPEN_OBJECT
+
+/* Action for each state and class of the next non-whitespace byte */
+static const uint8_t transitions[ST_COUNT][CC_COUNT] = {
+    [ST_VALUE] = {VALUE_ACTIONS},
+    [ST_FIRST_ELEMENT] = {VALUE_ACTIONS, [CC_CLOSE_ARRAY] = A_CLOSE},
+    [ST_FIRST_MEMBER] = {[CC_QUOTE] = A_KEY, [CC_CLOSE_OBJECT] = A_CLOSE},
+    [ST_MEMBER] = {[CC_QUOTE] = A_KEY},
+    [ST_COLON] = {[CC_COLON] = A_COLON},
+    [ST_AFTER_ELEMENT] = {[CC_COMMA] = A_NEXT_ELEMENT, [CC_CLOSE_ARRAY] = A_CLOSE},
+    [ST_AFTER_MEMBER] = {[CC_COMMA] = A_NEXT_MEMBER, [CC_CLOSE_OBJECT] = A_CLOSE},
+};
+
+#undef VALUE_ACTIONS
+
+/* State once a value inside the innermost open container is complete */
+static enum parse_state state_after_value(const struct parser *p)
+{
+    return p->stack[p->depth - 1].container->type == RJSON_ARRAY ? ST_AFTER_ELEMENT : ST_AFTER_MEMBER;
 }
 
-/**
- * @brief Adds a key-value pair to a JSON object.
- * This is "rock solid" - if realloc fails, it frees the new key/value
- * and leaves the original object unmodified.
- *
- * @param object The object to add to.
- * @param key The string key. The function makes its own copy.
- * @param value The value to add.
- * @return 0 on success, -1 on failure (out of memory).
+#if RJSON_TABLE_PARSER
+
+#if RJSON_COMPUTED_GOTO
+// Each action ends in its own indirect jump, so the branch predictor learns
+// the transitions per action instead of sharing one switch dispatch.
+#define ACTION(name) \
+    case name:       \
+    target_##name
+#define DISPATCH()                                                 \
+    do                                                             \
+    {                                                              \
+        skip_whitespace(p);                                        \
+        action = transitions[state][peek_class(p)];                \
+        __extension__({ goto *action_targets[action]; });          \
+    } while (0)
+#else
+#define ACTION(name) case name
+#define DISPATCH() goto dispatch
+#endif
+
+/*
+ * Parses any JSON value with the table-driven core: the class of the next
+ * byte and the current state select an action from `transitions`. Nesting
+ * is tracked on an explicit, heap-allocated container stack instead of the
+ * C call stack, so the depth limit (rjson_parse_options.max_depth) is
+ * independent of the thread's stack size.
  */
-int rjson_object_add(rjson_value *object, const char *key, rjson_value *value)
+static rjson_value *parse_value(struct parser *p)
 {
-    if (!object || object->type != RJSON_OBJECT || !key || !value)
+#if RJSON_COMPUTED_GOTO
+    static const void *const action_targets[A_COUNT] = {
+        [A_FAIL] = __extension__ &&target_A_FAIL,
+        [A_STRING] = __extension__ &&target_A_STRING,
+        [A_NUMBER] = __extension__ &&target_A_NUMBER,
+        [A_LITERAL] = __extension__ &&target_A_LITERAL,
+        [A_OPEN_ARRAY] = __extension__ &&target_A_OPEN_ARRAY,
+        [A_OPEN_OBJECT] = __extension__ &&target_A_OPEN_OBJECT,
+        [A_CLOSE] = __extension__ &&target_A_CLOSE,
+        [A_KEY] = __extension__ &&target_A_KEY,
+        [A_COLON] = __extension__ &&target_A_COLON,
+        [A_NEXT_ELEMENT] = __extension__ &&target_A_NEXT_ELEMENT,
+        [A_NEXT_MEMBER] = __extension__ &&target_A_NEXT_MEMBER,
+    };
+#endif
+    enum parse_state state = ST_VALUE;
+    unsigned action;
+    rjson_value *value;
+    struct member_key key = {0}; // Key of the member being parsed, when the innermost container is an object
+
+#if !RJSON_COMPUTED_GOTO
+dispatch:
+#endif
+    skip_whitespace(p);
+    action = transitions[state][peek_class(p)];
+#if RJSON_COMPUTED_GOTO
+    __extension__({ goto *action_targets[action]; });
+#endif
+    switch (action)
     {
-        return -1;
-    }
+    ACTION(A_STRING):
+        value = parse_string(p);
+        goto attach;
 
-    // 1. Prepare new key and value
-    char *new_key = (char *)malloc(strlen(key) + 1);
-    if (!new_key)
+    ACTION(A_NUMBER):
+        value = parse_scalar(p, parse_number);
+        goto attach;
+
+    ACTION(A_LITERAL):
+        value = parse_scalar(p, parse_literal);
+        goto attach;
+
+    ACTION(A_OPEN_ARRAY):
+    ACTION(A_OPEN_OBJECT):
     {
-        return -1;
+        int is_array = (action == A_OPEN_ARRAY);
+        p->cur++;
+        rjson_value *container = parser_new_value(p, is_array ? RJSON_ARRAY : RJSON_OBJECT);
+        if (!container)
+            goto fail;
+        int rc = open_container(p, container, key);
+        key.str = NULL;
+        if (rc != 0)
+            goto fail;
+        state = is_array ? ST_FIRST_ELEMENT : ST_FIRST_MEMBER;
+        DISPATCH();
     }
-    strcpy(new_key, key);
 
-    // 2. Try to grow arrays
-    size_t new_count = object->as.obj_val.count + 1;
-    char **new_keys = (char **)realloc(object->as.obj_val.keys, new_count * sizeof(char *));
-    if (!new_keys)
+    ACTION(A_CLOSE):
+        p->cur++;
+        value = close_container(p);
+        if (!value)
+            goto fail;
+        if (p->depth == 0)
+            return value;
+        state = state_after_value(p);
+        DISPATCH();
+
+    ACTION(A_KEY):
     {
-        free(new_key);
-        return -1; // Out of memory
+        if (parse_key(p, &key) != 0)
+            goto fail;
+        state = ST_COLON;
+        DISPATCH();
     }
-    object->as.obj_val.keys = new_keys;
 
-    rjson_value **new_values = (rjson_value **)realloc(object->as.obj_val.values, new_count * sizeof(rjson_value *));
-    if (!new_values)
-    {
-        // We are in a tricky spot. new_keys succeeded, but new_values failed.
-        // We must shrink new_keys back to be safe.
-        // This cast is to silence a -Wunused-result warning. We're in
-        // cleanup mode, so we don't care if it fails.
-        (void)realloc(object->as.obj_val.keys, (new_count - 1) * sizeof(char *));
-        free(new_key);
-        return -1; // Out of memory
+    ACTION(A_COLON):
+        p->cur++;
+        state = ST_VALUE;
+        DISPATCH();
+
+    ACTION(A_NEXT_ELEMENT):
+        p->cur++; // Skip comma
+        state = ST_VALUE;
+        DISPATCH();
+
+    ACTION(A_NEXT_MEMBER):
+        p->cur++; // Skip comma
+        state = ST_MEMBER;
+        DISPATCH();
+
+    ACTION(A_FAIL):
+    default:
+        goto fail; // Unexpected byte for this state
     }
-    object->as.obj_val.values = new_values;
 
-    // 3. Add new key and value
-    object->as.obj_val.keys[new_count - 1] = new_key;
-    object->as.obj_val.values[new_count - 1] = value;
-    object->as.obj_val.count = new_count;
+attach:
+    // A string or scalar is complete: attach it to the innermost container
+    if (!value)
+        goto fail;
+    if (p->depth == 0)
+        return value;
+    if (attach_value(p, value, &key) != 0)
+        goto fail;
+    state = state_after_value(p);
+    DISPATCH();
+
+fail:
+    parser_release_key(p, key.str);
+    parser_unwind(p);
+    return NULL;
+}
+
+#undef ACTION
+#undef DISPATCH
 
+#else // !RJSON_TABLE_PARSER
+
+/* Parses the key and ':' of the next object member into `key` */
+static int parse_member_key(struct parser *p, struct member_key *key)
+{
+    skip_whitespace(p);
+    if (peek_char(p) != '"')
+        return -1; // Key must be a string
+    if (parse_key(p, key) != 0)
+        return -1;
+
+    skip_whitespace(p);
+    if (peek_char(p) != ':')
+        return -1; // Expected colon; the caller releases the key
+    p->cur++; // Skip colon
     return 0;
 }
 
-// --- Serialization Implementation ---
-
-/**
- * @brief Escapes a string and appends it to the string buffer.
- * Does NOT include the opening/closing quotes.
+/*
+ * Parses any JSON value. Nesting is tracked on an explicit, heap-allocated
+ * container stack instead of the C call stack, so the depth limit
+ * (rjson_parse_options.max_depth) is independent of the thread's stack size.
  */
-static int escape_string(const char *in, struct strbuf *sb)
+static rjson_value *parse_value(struct parser *p)
 {
-    strbuf_append(sb, "\"", 1);
-
-    const char *p = in;
-    const char *start = in;
+    rjson_value *value;
+    struct member_key key = {0}; // Key of the member being parsed, when the innermost container is an object
 
-    while (*p)
+next_value:
+    value = NULL;
+    skip_whitespace(p);
+    switch (peek_char(p))
     {
-        char c = *p;
-        const char *replacement = NULL;
-        size_t len = 1;
-        char hex_buf[7];
+    case '"':
+        value = parse_string(p);
+        break;
+    case '[':
+    case '{':
+    {
+        int is_array = (*p->cur == '[');
+        p->cur++;
+        rjson_value *container = parser_new_value(p, is_array ? RJSON_ARRAY : RJSON_OBJECT);
+        if (!container)
+            goto fail;
+        int rc = open_container(p, container, key);
+        key.str = NULL;
+        if (rc != 0)
+            goto fail;
+
+        skip_whitespace(p);
+        if (peek_char(p) == (is_array ? ']' : '}'))
+        {
+            p->cur++; // Empty container
+            value = close_container(p);
+            if (!value)
+                goto fail;
+            goto close_value;
+        }
+        if (is_array)
+            goto next_value;
+        goto next_member;
+    }
+    case 't':
+    case 'f':
+    case 'n':
+        value = parse_scalar(p, parse_literal);
+        break;
+    default:
+        if (peek_class(p) == CC_NUMBER)
+            value = parse_scalar(p, parse_number);
+        break;
+    }
+    if (!value)
+        goto fail; // Invalid value
+
+    // Attach a finished scalar or string to its parent
+    if (p->depth > 0 && attach_value(p, value, &key) != 0)
+        goto fail;
+
+close_value:
+    // `value` is complete (and attached): continue in the enclosing container
+    while (p->depth > 0)
+    {
+        rjson_value *parent = p->stack[p->depth - 1].container;
+        char close = parent->type == RJSON_ARRAY ? ']' : '}';
+        skip_whitespace(p);
+        if (peek_char(p) == ',')
+        {
+            p->cur++; // Skip comma
+            if (parent->type == RJSON_ARRAY)
+                goto next_value;
+            goto next_member;
+        }
+        if (peek_char(p) != close)
+            goto fail; // Expected comma or closing bracket
+        p->cur++;
+        value = close_container(p);
+        if (!value)
+            goto fail;
+    }
+    return value;
+
+next_member:
+    if (parse_member_key(p, &key) != 0)
+        goto fail;
+    goto next_value;
+
+fail:
+    parser_release_key(p, key.str);
+    parser_unwind(p);
+    return NULL;
+}
+
+#endif // RJSON_TABLE_PARSER
+
+// --- Public API Implementation ---
+
+/*
+ * Prepares a parse of [cur, end): applies the default depth limit, skips a
+ * BOM and builds the structural index (stage 1) when the input is large
+ * enough. Release with parser_end().
+ */
+static void parser_begin(struct parser *p, struct rjson__index *index)
+{
+    if (p->max_depth == 0)
+        p->max_depth = RJSON_MAX_DEPTH;
+    // In-situ keys already cost no allocation; they stay in the buffer
+    p->intern = (p->flags & RJSON_PARSE_INTERN_KEYS) && !p->insitu;
+
+    // Harden: Skip UTF-8 BOM if present (EF BB BF)
+    if (match_literal(p, "\xEF\xBB\xBF", 3))
+        p->cur += 3;
+
+    // Stage 1: locate every token with SIMD so the grammar below jumps from
+    // token to token. Without an index it scans the bytes itself.
+    index->positions = NULL;
+    index->count = 0;
+    if (!(p->flags & RJSON_PARSE_NO_INDEX) && (size_t)(p->end - p->cur) >= RJSON_INDEX_MIN_LENGTH &&
+        rjson__index_build(p->cur, (size_t)(p->end - p->cur), index) == 0)
+    {
+        p->base = p->cur;
+        p->next = index->positions;
+    }
+}
+
+/* Releases the per-parse buffers acquired by parser_begin() and the parse */
+static void parser_end(struct parser *p, struct rjson__index *index)
+{
+    rjson__index_free(index);
+    p->next = NULL;
+    free(p->scratch);
+    p->scratch = NULL;
+    free(p->stack);
+    p->stack = NULL;
+    free(p->pending);
+    p->pending = NULL;
+    free(p->pending_keys);
+    p->pending_keys = NULL;
+    free(p->keys.slots); // The keys themselves belong to the document
+    memset(&p->keys, 0, sizeof(p->keys));
+}
+
+/* Parses a complete document held in [cur, end) */
+static rjson_value *parse_document(struct parser *p)
+{
+    struct rjson__index index;
+    parser_begin(p, &index);
+    rjson_value *result = parse_value(p);
+    if (result)
+        skip_whitespace(p);
+    parser_end(p, &index);
+
+    if (!result)
+    {
+        // Library should not log, just fail.
+        return NULL;
+    }
+
+    if (p->cur != p->end)
+    {
+        // Library should not log. Fail due to extra characters.
+        rjson_free(result);
+        return NULL;
+    }
+
+    return result;
+}
+
+rjson_value *rjson_parse_ex(const char *json, size_t length, const rjson_parse_options *options)
+{
+    if (!json)
+        return NULL;
+
+    struct parser p = {0};
+    p.cur = json;
+    p.end = json + length;
+    if (options)
+    {
+        p.flags = options->flags;
+        p.arena = options->arena;
+        p.max_depth = options->max_depth;
+    }
+    return parse_document(&p);
+}
+
+rjson_value *rjson_parse(const char *json_string)
+{
+    if (!json_string)
+        return NULL;
+    return rjson_parse_ex(json_string, strlen(json_string), NULL);
+}
+
+rjson_value *rjson_parse_insitu(char *buffer, size_t length, const rjson_parse_options *options)
+{
+    if (!buffer)
+        return NULL;
+
+    struct parser p = {0};
+    p.cur = buffer;
+    p.end = buffer + length;
+    p.insitu = 1;
+    if (options)
+    {
+        p.flags = options->flags;
+        p.arena = options->arena;
+        p.max_depth = options->max_depth;
+    }
+    return parse_document(&p);
+}
+
+rjson_value *rjson_parse_n(const char *json, size_t length)
+{
+    return rjson_parse_ex(json, length, NULL);
+}
+
+rjson_value *rjson_parse_arena(rjson_arena *arena, const char *json_string)
+{
+    if (!arena || !json_string)
+        return NULL;
+
+    rjson_parse_options options = {0};
+    options.arena = arena;
+    return rjson_parse_ex(json_string, strlen(json_string), &options);
+}
+
+// --- SAX Parser ---
+
+/* Calls an optional SAX callback; a missing one continues the parse */
+#define SAX_CALL(handler, callback, ...) \
+    ((handler)->callback ? (handler)->callback(__VA_ARGS__) : RJSON_SAX_CONTINUE)
+
+/*
+ * Runs the grammar over the whole input and reports it to `handler`
+ * instead of building a tree. Memory use is bounded by the nesting depth:
+ * one byte per open container, plus the decode buffer of escaped strings.
+ */
+static int sax_run(struct parser *p, const rjson_sax_handler *handler, void *ctx)
+{
+    unsigned char *is_array = NULL; // Kind of each open container, innermost last
+    size_t depth = 0;
+    size_t cap = 0;
+    size_t skip = 0;    // Open containers being skipped (no events while nonzero)
+    int skip_value = 0; // A key callback asked to skip the member's value
+    enum parse_state state = ST_VALUE;
+    int rc = -1;
+
+    while (1)
+    {
+        skip_whitespace(p);
+        unsigned action = transitions[state][peek_class(p)];
+        int emit = (skip == 0 && !skip_value);
+        int result = RJSON_SAX_CONTINUE;
+        int completed = 0; // A value (scalar or container) ended
+
+        switch (action)
+        {
+        case A_STRING:
+        case A_KEY:
+        {
+            size_t len;
+            int escaped;
+            const char *s = read_string(p, &len, &escaped);
+            if (!s)
+                goto done;
+            if (action == A_STRING)
+            {
+                if (emit)
+                    result = SAX_CALL(handler, string, ctx, s, len);
+                completed = 1;
+                break;
+            }
+            if (skip == 0)
+            {
+                result = SAX_CALL(handler, key, ctx, s, len);
+                if (result == RJSON_SAX_SKIP)
+                {
+                    skip_value = 1;
+                    result = RJSON_SAX_CONTINUE;
+                }
+            }
+            state = ST_COLON;
+            break;
+        }
+        case A_NUMBER:
+        case A_LITERAL:
+        {
+            rjson_value scalar; // Only valid during the callback
+            int ok = (action == A_NUMBER ? read_number(p, &scalar) : read_literal(p, &scalar)) == 0;
+            if (!ok || !scalar_ends_cleanly(p))
+                goto done;
+            if (emit)
+            {
+                if (scalar.type == RJSON_NUMBER)
+                    result = SAX_CALL(handler, number, ctx, &scalar);
+                else if (scalar.type == RJSON_BOOL)
+                    result = SAX_CALL(handler, boolean, ctx, scalar.as.bool_val);
+                else
+                    result = SAX_CALL(handler, null, ctx);
+            }
+            completed = 1;
+            break;
+        }
+        case A_OPEN_ARRAY:
+        case A_OPEN_OBJECT:
+        {
+            if (depth >= p->max_depth)
+                goto done; // Depth limit
+            if (depth == cap)
+            {
+                size_t new_cap = cap ? cap * 2 : 32;
+                unsigned char *grown = (unsigned char *)realloc(is_array, new_cap);
+                if (!grown)
+                    goto done;
+                is_array = grown;
+                cap = new_cap;
+            }
+            is_array[depth++] = (action == A_OPEN_ARRAY);
+            p->cur++;
+            if (skip > 0)
+                skip++;
+            else if (skip_value)
+            {
+                skip = 1;
+                skip_value = 0;
+            }
+            else
+            {
+                result = action == A_OPEN_ARRAY ? SAX_CALL(handler, start_array, ctx)
+                                                : SAX_CALL(handler, start_object, ctx);
+                if (result == RJSON_SAX_SKIP)
+                {
+                    skip = 1;
+                    result = RJSON_SAX_CONTINUE;
+                }
+            }
+            state = (action == A_OPEN_ARRAY) ? ST_FIRST_ELEMENT : ST_FIRST_MEMBER;
+            break;
+        }
+        case A_CLOSE:
+            p->cur++;
+            depth--;
+            if (skip > 0)
+                skip--; // Skipped containers end without an event
+            else
+                result = is_array[depth] ? SAX_CALL(handler, end_array, ctx) : SAX_CALL(handler, end_object, ctx);
+            completed = 1;
+            break;
+        case A_COLON:
+        case A_NEXT_ELEMENT:
+            p->cur++;
+            state = ST_VALUE;
+            break;
+        case A_NEXT_MEMBER:
+            p->cur++;
+            state = ST_MEMBER;
+            break;
+        default:
+            goto done; // Unexpected byte for this state
+        }
+
+        if (result != RJSON_SAX_CONTINUE && result != RJSON_SAX_SKIP)
+            goto done; // Aborted by a callback
+        if (completed)
+        {
+            skip_value = 0;
+            if (depth == 0)
+                break;
+            state = is_array[depth - 1] ? ST_AFTER_ELEMENT : ST_AFTER_MEMBER;
+        }
+    }
+
+    skip_whitespace(p);
+    if (p->cur == p->end)
+        rc = 0; // Otherwise: extra characters after the document
+done:
+    free(is_array);
+    return rc;
+}
+
+#undef SAX_CALL
+
+int rjson_sax_parse(const char *json, size_t length, const rjson_sax_handler *handler, void *ctx,
+                    const rjson_parse_options *options)
+{
+    if (!json || !handler)
+        return -1;
+
+    struct parser p = {0};
+    p.cur = json;
+    p.end = json + length;
+    if (options)
+    {
+        p.flags = options->flags;
+        p.max_depth = options->max_depth;
+    }
+    struct rjson__index index;
+    parser_begin(&p, &index);
+    int rc = sax_run(&p, handler, ctx);
+    parser_end(&p, &index);
+    return rc;
+}
+
+// --- Push Parser ---
+
+/* Token carried across chunk boundaries by the push parser */
+enum push_token
+{
+    TOKEN_NONE = 0,
+    TOKEN_STRING, // A string value, or a key (see token_is_key)
+    TOKEN_NUMBER,
+    TOKEN_LITERAL
+};
+
+struct rjson_push_parser
+{
+    // Container stack, options and decode scratch; cur/end span the chunk being fed
+    struct parser p;
+    enum parse_state state;
+    struct member_key key; // Key of the member being parsed
+    rjson_value *root;     // The completed document, until rjson_push_finish()
+    int failed;        // Sticky: the partial tree has been released
+    int finished;
+    unsigned bom; // Bytes of a leading UTF-8 BOM seen (3 once past the document start)
+
+    // A token split across chunks is accumulated here until its end arrives.
+    // Only that token is copied, never the whole body.
+    enum push_token token;
+    int token_is_key;
+    int token_escape; // The carried string ends in the middle of an escape
+    struct strbuf token_buf;
+};
+
+/*
+ * Finds the end of a string body in [s, end) (`s` is past the opening
+ * quote) without decoding it. Returns the position just past the closing
+ * quote, or NULL if the input ends first. `escape` carries an unfinished
+ * escape across calls. A control character also ends the scan; the string
+ * decoder rejects it.
+ */
+static const char *string_body_end(const char *s, const char *end, int *escape)
+{
+    if (*escape)
+    {
+        if (s == end)
+            return NULL;
+        s++; // The escaped byte
+        *escape = 0;
+    }
+    while (1)
+    {
+        s += rjson__string_span(s, (size_t)(end - s));
+        if (s == end)
+            return NULL;
+        if (*s != '\\')
+            return s + 1;
+        if (++s == end)
+        {
+            *escape = 1;
+            return NULL;
+        }
+        s++;
+    }
+}
+
+/* Returns nonzero if `c` can continue a number or literal token */
+static int push_token_continues(enum push_token token, char c)
+{
+    if (token == TOKEN_NUMBER)
+        return char_class[(unsigned char)c] == CC_NUMBER || c == '.' || c == 'e' || c == 'E' || c == '+';
+    return c >= 'a' && c <= 'z';
+}
+
+/*
+ * Finds the end of a token in [s, end), starting after the opening quote
+ * for strings. Returns the position just past it, or NULL if the chunk ends
+ * first. `escape` carries an unfinished string escape across chunks.
+ */
+static const char *push_token_end(enum push_token token, const char *s, const char *end, int *escape)
+{
+    if (token != TOKEN_STRING)
+    {
+        // Numbers and literals end at the first byte that cannot continue them
+        while (s < end && push_token_continues(token, *s))
+            s++;
+        return s < end ? s : NULL;
+    }
+
+    return string_body_end(s, end, escape);
+}
+
+/* Releases the partial tree and puts the parser in the failed state */
+static int push_fail(rjson_push_parser *pp)
+{
+    struct parser *p = &pp->p;
+    parser_release_key(p, pp->key.str);
+    pp->key.str = NULL;
+    parser_unwind(p);
+    rjson_free(pp->root);
+    pp->root = NULL;
+    pp->token = TOKEN_NONE;
+    pp->failed = 1;
+    return -1;
+}
+
+/* Attaches a completed value to the innermost container, or makes it the root */
+static int push_value(rjson_push_parser *pp, rjson_value *value)
+{
+    struct parser *p = &pp->p;
+    if (p->depth == 0)
+    {
+        pp->root = value;
+        return 0;
+    }
+    if (attach_value(p, value, &pp->key) != 0)
+        return -1;
+    pp->state = state_after_value(p);
+    return 0;
+}
+
+/* Decodes the complete token held in [s, end) with the regular token parsers */
+static int push_complete_token(rjson_push_parser *pp, const char *s, const char *end)
+{
+    struct parser *p = &pp->p;
+    enum push_token token = pp->token;
+    pp->token = TOKEN_NONE;
+    p->cur = s;
+    p->end = end;
+
+    if (token == TOKEN_STRING && pp->token_is_key)
+    {
+        if (parse_key(p, &pp->key) != 0)
+            return -1;
+        pp->state = ST_COLON;
+        return 0;
+    }
+
+    rjson_value *value = token == TOKEN_STRING   ? parse_string(p)
+                         : token == TOKEN_NUMBER ? parse_number(p)
+                                                 : parse_literal(p);
+    if (value && p->cur != end)
+    {
+        rjson_free(value); // Trailing bytes, e.g. "1.2.3" or "truex"
+        value = NULL;
+    }
+    return value ? push_value(pp, value) : -1;
+}
+
+rjson_push_parser *rjson_push_parser_new(const rjson_parse_options *options)
+{
+    rjson_push_parser *pp = (rjson_push_parser *)calloc(1, sizeof(rjson_push_parser));
+    if (!pp)
+        return NULL;
+    if (options)
+    {
+        // Chunks are transient: strings and numbers can never reference them
+        pp->p.flags = options->flags & ~(RJSON_PARSE_PADDED | RJSON_PARSE_ZEROCOPY | RJSON_PARSE_LAZY_NUMBERS);
+        pp->p.arena = options->arena;
+        pp->p.max_depth = options->max_depth;
+    }
+    if (pp->p.max_depth == 0)
+        pp->p.max_depth = RJSON_MAX_DEPTH;
+    pp->p.intern = (pp->p.flags & RJSON_PARSE_INTERN_KEYS) != 0;
+    pp->state = ST_VALUE;
+    return pp;
+}
+
+int rjson_push_feed(rjson_push_parser *pp, const char *chunk, size_t len)
+{
+    if (!pp || pp->failed || pp->finished || (!chunk && len))
+        return -1;
+    struct parser *p = &pp->p;
+    const char *cur = chunk;
+    const char *end = chunk + len;
+
+    // Harden: Skip UTF-8 BOM if present (EF BB BF), even when split
+    while (pp->bom < 3 && cur < end)
+    {
+        if (*cur != "\xEF\xBB\xBF"[pp->bom])
+        {
+            if (pp->bom > 0)
+                return push_fail(pp); // Partial BOM
+            pp->bom = 3;
+            break;
+        }
+        pp->bom++;
+        cur++;
+    }
+
+    // Finish a token left open by the previous chunk
+    if (pp->token != TOKEN_NONE)
+    {
+        const char *stop = push_token_end(pp->token, cur, end, &pp->token_escape);
+        if (strbuf_append(&pp->token_buf, cur, (size_t)((stop ? stop : end) - cur)) != 0)
+            return push_fail(pp);
+        if (!stop)
+            return 0;
+        cur = stop;
+        if (push_complete_token(pp, pp->token_buf.buffer, pp->token_buf.buffer + pp->token_buf.length) != 0)
+            return push_fail(pp);
+        pp->token_buf.length = 0;
+    }
+
+    while (1)
+    {
+        p->cur = cur;
+        p->end = end;
+        skip_whitespace(p);
+        cur = p->cur;
+        if (cur == end)
+            return 0;
+        if (pp->root)
+            return push_fail(pp); // Extra characters after the document
+
+        unsigned action = transitions[pp->state][peek_class(p)];
+        switch (action)
+        {
+        case A_STRING:
+        case A_KEY:
+        case A_NUMBER:
+        case A_LITERAL:
+        {
+            pp->token = action == A_NUMBER ? TOKEN_NUMBER : action == A_LITERAL ? TOKEN_LITERAL : TOKEN_STRING;
+            pp->token_is_key = (action == A_KEY);
+            pp->token_escape = 0;
+            const char *stop = push_token_end(pp->token, pp->token == TOKEN_STRING ? cur + 1 : cur, end, &pp->token_escape);
+            if (!stop)
+            {
+                // The token continues in the next chunk
+                if (strbuf_append(&pp->token_buf, cur, (size_t)(end - cur)) != 0)
+                    return push_fail(pp);
+                return 0;
+            }
+            if (push_complete_token(pp, cur, stop) != 0)
+                return push_fail(pp);
+            cur = stop;
+            break;
+        }
+        case A_OPEN_ARRAY:
+        case A_OPEN_OBJECT:
+        {
+            int is_array = (action == A_OPEN_ARRAY);
+            rjson_value *container = parser_new_value(p, is_array ? RJSON_ARRAY : RJSON_OBJECT);
+            if (!container)
+                return push_fail(pp);
+            int rc = open_container(p, container, pp->key);
+            pp->key.str = NULL;
+            if (rc != 0)
+                return push_fail(pp);
+            pp->state = is_array ? ST_FIRST_ELEMENT : ST_FIRST_MEMBER;
+            cur++;
+            break;
+        }
+        case A_CLOSE:
+        {
+            rjson_value *value = close_container(p);
+            if (!value)
+                return push_fail(pp);
+            if (p->depth == 0)
+                pp->root = value;
+            else
+                pp->state = state_after_value(p);
+            cur++;
+            break;
+        }
+        case A_COLON:
+        case A_NEXT_ELEMENT:
+            pp->state = ST_VALUE;
+            cur++;
+            break;
+        case A_NEXT_MEMBER:
+            pp->state = ST_MEMBER;
+            cur++;
+            break;
+        default:
+            return push_fail(pp); // Unexpected byte for this state
+        }
+    }
+}
+
+rjson_value *rjson_push_finish(rjson_push_parser *pp)
+{
+    if (!pp || pp->failed || pp->finished)
+        return NULL;
+    pp->finished = 1;
+
+    // The end of the input delimits a trailing number or literal
+    if (pp->token == TOKEN_NUMBER || pp->token == TOKEN_LITERAL)
+    {
+        if (push_complete_token(pp, pp->token_buf.buffer, pp->token_buf.buffer + pp->token_buf.length) != 0)
+        {
+            push_fail(pp);
+            return NULL;
+        }
+    }
+    if (!pp->root || pp->token != TOKEN_NONE)
+    {
+        push_fail(pp); // Incomplete document
+        return NULL;
+    }
+
+    rjson_value *root = pp->root;
+    pp->root = NULL;
+    return root;
+}
+
+void rjson_push_parser_free(rjson_push_parser *pp)
+{
+    if (!pp)
+        return;
+    push_fail(pp); // Releases a partial or unclaimed document
+    strbuf_free(&pp->token_buf);
+    free(pp->p.stack);
+    free(pp->p.pending);
+    free(pp->p.pending_keys);
+    free(pp->p.keys.slots);
+    free(pp->p.scratch);
+    free(pp);
+}
+
+// --- On-demand Cursor ---
+
+// Set on cursors produced by array iteration: the value is an array element
+#define CURSOR_ELEMENT 0x1u
+
+/* Skips JSON whitespace in [s, end) */
+static const char *cursor_skip_whitespace(const char *s, const char *end)
+{
+    while (s < end && char_class[(unsigned char)*s] == CC_SPACE)
+        s++;
+    return s;
+}
+
+/*
+ * Returns the position just past the value starting at `s` without building
+ * or validating it, or NULL if the input ends first. Containers are skipped
+ * by SIMD bracket matching, scalars up to the next delimiter.
+ */
+static const char *cursor_skip_value(const char *s, const char *end)
+{
+    if (s == end)
+        return NULL;
+    switch (char_class[(unsigned char)*s])
+    {
+    case CC_QUOTE:
+    {
+        int escape = 0;
+        return string_body_end(s + 1, end, &escape);
+    }
+    case CC_OPEN_ARRAY:
+    case CC_OPEN_OBJECT:
+        return rjson__skip_container(s, end);
+    case CC_NUMBER:
+    case CC_LITERAL:
+        while (s < end && (char_class[(unsigned char)*s] < CC_SPACE || char_class[(unsigned char)*s] > CC_CLOSE_OBJECT))
+            s++;
+        return s;
+    default:
+        return NULL;
+    }
+}
+
+/* Points `out` at the value starting at or after `s` */
+static int cursor_at(rjson_cursor *out, const char *s, const char *end, unsigned int flags)
+{
+    s = cursor_skip_whitespace(s, end);
+    if (s == end)
+        return -1;
+    out->pos = s;
+    out->end = end;
+    out->flags = flags;
+    return 0;
+}
+
+int rjson_cursor_init(rjson_cursor *cursor, const char *json, size_t length)
+{
+    if (!cursor || !json)
+        return -1;
+    const char *end = json + length;
+    // Harden: Skip UTF-8 BOM if present (EF BB BF)
+    if (length >= 3 && memcmp(json, "\xEF\xBB\xBF", 3) == 0)
+        json += 3;
+    return cursor_at(cursor, json, end, 0);
+}
+
+int rjson_cursor_get_type(const rjson_cursor *cursor, rjson_type *out)
+{
+    if (!cursor || !out || cursor->pos == cursor->end)
+        return -1;
+    switch (char_class[(unsigned char)*cursor->pos])
+    {
+    case CC_QUOTE:
+        *out = RJSON_STRING;
+        return 0;
+    case CC_NUMBER:
+        *out = RJSON_NUMBER;
+        return 0;
+    case CC_OPEN_ARRAY:
+        *out = RJSON_ARRAY;
+        return 0;
+    case CC_OPEN_OBJECT:
+        *out = RJSON_OBJECT;
+        return 0;
+    case CC_LITERAL:
+        *out = (*cursor->pos == 'n') ? RJSON_NULL : RJSON_BOOL;
+        return 0;
+    default:
+        return -1;
+    }
+}
+
+int rjson_cursor_find_field(const rjson_cursor *object, const char *key, rjson_cursor *out)
+{
+    if (!object || !key || !out || object->pos == object->end || *object->pos != '{')
+        return -1;
+    const char *end = object->end;
+    const char *s = cursor_skip_whitespace(object->pos + 1, end);
+    size_t key_len = strlen(key);
+    if (s < end && *s == '}')
+        return -1; // Empty object
+
+    struct parser p = {0}; // Decodes escaped keys
+    p.end = end;
+    int rc = -1;
+    while (s < end && *s == '"')
+    {
+        // Escape-free keys are compared in place, others decoded first
+        int escape = 0;
+        const char *key_end = string_body_end(s + 1, end, &escape);
+        if (!key_end)
+            break;
+        int match;
+        size_t raw_len = (size_t)(key_end - s - 2);
+        if (!memchr(s + 1, '\\', raw_len))
+            match = raw_len == key_len && memcmp(s + 1, key, key_len) == 0;
+        else
+        {
+            size_t len;
+            int escaped;
+            p.cur = s;
+            const char *decoded = read_string(&p, &len, &escaped);
+            if (!decoded)
+                break;
+            match = len == key_len && memcmp(decoded, key, key_len) == 0;
+        }
+
+        s = cursor_skip_whitespace(key_end, end);
+        if (s == end || *s != ':')
+            break;
+        s = cursor_skip_whitespace(s + 1, end);
+        if (match)
+        {
+            rc = cursor_at(out, s, end, 0);
+            break;
+        }
+
+        // Not this member: skip its value without looking inside
+        s = cursor_skip_value(s, end);
+        if (!s)
+            break;
+        s = cursor_skip_whitespace(s, end);
+        if (s == end || *s != ',')
+            break; // '}' (not found) or malformed
+        s = cursor_skip_whitespace(s + 1, end);
+    }
+    free(p.scratch);
+    return rc;
+}
+
+int rjson_cursor_first_element(const rjson_cursor *array, rjson_cursor *out)
+{
+    if (!array || !out || array->pos == array->end || *array->pos != '[')
+        return -1;
+    const char *s = cursor_skip_whitespace(array->pos + 1, array->end);
+    if (s == array->end || *s == ']')
+        return -1; // Empty array
+    return cursor_at(out, s, array->end, CURSOR_ELEMENT);
+}
+
+int rjson_cursor_next_element(rjson_cursor *element)
+{
+    if (!element || !(element->flags & CURSOR_ELEMENT))
+        return -1;
+    const char *s = cursor_skip_value(element->pos, element->end);
+    if (!s)
+        return -1;
+    s = cursor_skip_whitespace(s, element->end);
+    if (s == element->end || *s != ',')
+        return -1; // ']' (no more elements) or malformed
+    return cursor_at(element, s + 1, element->end, CURSOR_ELEMENT);
+}
+
+/* Decodes the number at the cursor into a temporary node */
+static int cursor_number(const rjson_cursor *cursor, rjson_value *out)
+{
+    if (!cursor || cursor->pos == cursor->end || char_class[(unsigned char)*cursor->pos] != CC_NUMBER)
+        return -1;
+    struct parser p = {0};
+    p.cur = cursor->pos;
+    p.end = cursor->end;
+    return read_number(&p, out);
+}
+
+int rjson_cursor_get_double(const rjson_cursor *cursor, double *out)
+{
+    rjson_value num;
+    if (!out || cursor_number(cursor, &num) != 0)
+        return -1;
+    *out = num.as.num_val;
+    return 0;
+}
+
+int rjson_cursor_get_int64(const rjson_cursor *cursor, int64_t *out)
+{
+    rjson_value num;
+    if (!out || cursor_number(cursor, &num) != 0)
+        return -1;
+    return rjson_number_get_int64(&num, out);
+}
+
+int rjson_cursor_get_bool(const rjson_cursor *cursor, int *out)
+{
+    if (!cursor || !out)
+        return -1;
+    struct parser p = {0};
+    p.cur = cursor->pos;
+    p.end = cursor->end;
+    rjson_value lit;
+    if (read_literal(&p, &lit) != 0 || lit.type != RJSON_BOOL)
+        return -1;
+    *out = lit.as.bool_val;
+    return 0;
+}
+
+int rjson_cursor_get_string_view(const rjson_cursor *cursor, const char **str, size_t *len)
+{
+    if (!cursor || !str || cursor->pos == cursor->end || *cursor->pos != '"')
+        return -1;
+    int escape = 0;
+    const char *end = string_body_end(cursor->pos + 1, cursor->end, &escape);
+    if (!end || end[-1] != '"')
+        return -1; // Unterminated, or a raw control character
+    size_t n = (size_t)(end - cursor->pos - 2);
+    if (memchr(cursor->pos + 1, '\\', n))
+        return -1; // Escaped: decode with rjson_cursor_get_value()
+    *str = cursor->pos + 1;
+    if (len)
+        *len = n;
+    return 0;
+}
+
+rjson_value *rjson_cursor_get_value(const rjson_cursor *cursor, const rjson_parse_options *options)
+{
+    if (!cursor)
+        return NULL;
+    const char *end = cursor_skip_value(cursor->pos, cursor->end);
+    if (!end)
+        return NULL;
+    return rjson_parse_ex(cursor->pos, (size_t)(end - cursor->pos), options);
+}
+
+// --- Parallel Parsing ---
+
+// Chunks per worker: enough for load balancing without much claiming overhead
+#define PARALLEL_CHUNKS_PER_WORKER 8
+
+// Smallest run of the root's children handed to one worker. Documents shorter
+// than two chunks are parsed on the calling thread.
+#ifndef RJSON_PARALLEL_MIN_CHUNK
+#define RJSON_PARALLEL_MIN_CHUNK (64 * 1024)
+#endif
+
+/* A run of elements (or members) of the root container */
+struct parallel_chunk
+{
+    const char *begin; // Just past the '[', '{' or ',' before its first child
+    const char *end;   // The ',' or closing bracket after its last child
+    rjson_value *part; // Container holding the parsed children
+};
+
+/* State shared by all workers of one parse */
+struct parallel_job
+{
+    struct parallel_chunk *chunks;
+    size_t chunk_count;
+    atomic_size_t next_chunk; // Next chunk to claim
+    atomic_int failed;        // A chunk is invalid, or OOM
+    rjson_type type;          // Of the root container
+    unsigned int flags;
+    size_t max_depth; // For the root's children: one level is the root itself
+};
+
+struct parallel_worker
+{
+    struct parallel_job *job;
+    rjson_arena *arena; // NULL for heap documents
+};
+
+/*
+ * Splits the root container whose opening bracket is at `s` into chunks of
+ * about `chunk_size` bytes, cutting only at its own commas. The children are
+ * skipped by bracket matching without being validated; the root's own
+ * punctuation and the trailing whitespace are checked. Returns the number of
+ * chunks, or 0 if the pre-scan cannot follow the document, which then goes
+ * to the sequential parser (so every error is reported exactly as there).
+ */
+static size_t parallel_split(const char *s, const char *end, size_t chunk_size, struct parallel_chunk *chunks,
+                             size_t max_chunks)
+{
+    int is_object = (*s == '{');
+    char close = is_object ? '}' : ']';
+    const char *begin = ++s;
+    size_t count = 0;
+
+    s = cursor_skip_whitespace(s, end);
+    if (s == end || *s == close)
+        return 0; // Empty (or truncated): nothing to split
+    while (1)
+    {
+        if (is_object)
+        {
+            int escape = 0;
+            if (*s != '"' || !(s = string_body_end(s + 1, end, &escape)))
+                return 0;
+            s = cursor_skip_whitespace(s, end);
+            if (s == end || *s != ':')
+                return 0;
+            s = cursor_skip_whitespace(s + 1, end);
+        }
+        s = cursor_skip_value(s, end);
+        if (!s)
+            return 0;
+        s = cursor_skip_whitespace(s, end);
+        if (s == end)
+            return 0;
+        if (*s == close)
+            break;
+        if (*s != ',')
+            return 0;
+        if ((size_t)(s - begin) >= chunk_size && count + 1 < max_chunks)
+        {
+            chunks[count].begin = begin;
+            chunks[count].end = s;
+            count++;
+            begin = s + 1;
+        }
+        s = cursor_skip_whitespace(s + 1, end);
+        if (s == end)
+            return 0;
+    }
+    chunks[count].begin = begin;
+    chunks[count].end = s;
+    count++;
+    return cursor_skip_whitespace(s + 1, end) == end ? count : 0;
+}
+
+/*
+ * Parses the children of one chunk, with the usual grammar and validation,
+ * into a container of the root's type. Returns 0 or -1.
+ */
+static int parallel_parse_chunk(const struct parallel_job *job, struct parallel_chunk *chunk, rjson_arena *arena)
+{
+    struct parser p = {0};
+    p.cur = chunk->begin;
+    p.end = chunk->end;
+    p.flags = job->flags;
+    p.arena = arena;
+    p.max_depth = job->max_depth;
+
+    struct rjson__index index;
+    parser_begin(&p, &index);
+    rjson_value *part = parser_new_value(&p, job->type); // After parser_begin(): inherits interned keys
+    int rc = part ? 0 : -1;
+    while (rc == 0)
+    {
+        struct member_key key = {0};
+        if (job->type == RJSON_OBJECT)
+        {
+            skip_whitespace(&p);
+            if (peek_class(&p) != CC_QUOTE || parse_key(&p, &key) != 0)
+            {
+                rc = -1;
+                break;
+            }
+            skip_whitespace(&p);
+            if (peek_class(&p) != CC_COLON)
+            {
+                parser_release_key(&p, key.str);
+                rc = -1;
+                break;
+            }
+            p.cur++;
+        }
+
+        rjson_value *value = parse_value(&p);
+        if (!value)
+        {
+            parser_release_key(&p, key.str);
+            rc = -1;
+            break;
+        }
+        rc = attach_value(&p, value, &key); // Pending until the whole chunk is parsed
+        if (rc != 0)
+            break;
+
+        skip_whitespace(&p);
+        if (p.cur == p.end)
+            break;
+        if (peek_class(&p) != CC_COMMA)
+            rc = -1;
+        p.cur++;
+    }
+    if (rc == 0)
+        rc = container_fill(&p, part, 0);
+    if (rc != 0)
+        parser_unwind(&p);
+    parser_end(&p, &index);
+
+    if (rc != 0)
+    {
+        rjson_free(part);
+        return -1;
+    }
+    chunk->part = part;
+    return 0;
+}
+
+/* Claims and parses chunks until none are left or one has failed */
+static void *parallel_worker_main(void *arg)
+{
+    struct parallel_worker *worker = (struct parallel_worker *)arg;
+    struct parallel_job *job = worker->job;
+    while (!atomic_load(&job->failed))
+    {
+        size_t c = atomic_fetch_add(&job->next_chunk, 1);
+        if (c >= job->chunk_count)
+            break;
+        if (parallel_parse_chunk(job, &job->chunks[c], worker->arena) != 0)
+            atomic_store(&job->failed, 1);
+    }
+    return NULL;
+}
+
+/*
+ * Moves the children of every chunk, in order, into one root container.
+ * The emptied parts are released (their children now belong to the root).
+ * Returns NULL on OOM.
+ */
+static rjson_value *parallel_join(struct parallel_job *job, rjson_arena *arena)
+{
+    struct parser p = {0};
+    p.arena = arena;
+    p.intern = (job->flags & RJSON_PARSE_INTERN_KEYS) != 0; // The parts' keys move to the root
+    rjson_value *root = parser_new_value(&p, job->type);
+    if (!root)
+        return NULL;
+
+    size_t total = 0;
+    for (size_t c = 0; c < job->chunk_count; c++)
+    {
+        const rjson_value *part = job->chunks[c].part;
+        total += part->type == RJSON_ARRAY ? part->as.arr_val.count : part->as.obj_val.count;
+    }
+
+    if (job->type == RJSON_ARRAY)
+    {
+        rjson_value **elements = (rjson_value **)parser_alloc(&p, total * sizeof(rjson_value *));
+        if (!elements)
+        {
+            rjson_free(root);
+            return NULL;
+        }
+        rjson_array *arr = &root->as.arr_val;
+        arr->elements = elements;
+        for (size_t c = 0; c < job->chunk_count; c++)
+        {
+            rjson_array *part = &job->chunks[c].part->as.arr_val;
+            memcpy(arr->elements + arr->count, part->elements, part->count * sizeof(rjson_value *));
+            arr->count += part->count;
+            part->count = 0;
+        }
+    }
+    else
+    {
+        char **keys = (char **)parser_alloc(&p, total * sizeof(char *));
+        rjson_value **values = (rjson_value **)parser_alloc(&p, total * sizeof(rjson_value *));
+        if (!keys || !values)
+        {
+            if (!arena)
+            {
+                free(keys);
+                free(values);
+            }
+            rjson_free(root);
+            return NULL;
+        }
+        rjson_object *obj = &root->as.obj_val;
+        obj->keys = keys;
+        obj->values = values;
+        for (size_t c = 0; c < job->chunk_count; c++)
+        {
+            rjson_object *part = &job->chunks[c].part->as.obj_val;
+            memcpy(obj->keys + obj->count, part->keys, part->count * sizeof(char *));
+            memcpy(obj->values + obj->count, part->values, part->count * sizeof(rjson_value *));
+            obj->count += part->count;
+            part->count = 0;
+        }
+        parser_index_object(&p, obj); // The parts have none: they are only joined
+    }
+
+    for (size_t c = 0; c < job->chunk_count; c++)
+    {
+        rjson_free(job->chunks[c].part); // Empty now: releases only its own storage
+        job->chunks[c].part = NULL;
+    }
+    return root;
+}
+
+/* Cleanup callback that ties a worker's arena to the caller's */
+static void parallel_arena_release(void *arena)
+{
+    rjson_arena_free((rjson_arena *)arena);
+}
+
+/*
+ * Creates the workers. Worker 0 runs on the calling thread and allocates
+ * straight from the caller's arena; the others get arenas of their own,
+ * released together with it. Returns NULL on OOM.
+ */
+static struct parallel_worker *parallel_workers_new(struct parallel_job *job, size_t count, rjson_arena *arena)
+{
+    struct parallel_worker *workers = (struct parallel_worker *)calloc(count, sizeof(struct parallel_worker));
+    if (!workers)
+        return NULL;
+    for (size_t i = 0; i < count; i++)
+    {
+        workers[i].job = job;
+        if (i == 0 || !arena)
+        {
+            workers[i].arena = arena;
+            continue;
+        }
+        workers[i].arena = rjson_arena_new(0);
+        if (!workers[i].arena || rjson_arena_add_cleanup(arena, parallel_arena_release, workers[i].arena) != 0)
+        {
+            rjson_arena_free(workers[i].arena);
+            free(workers);
+            return NULL; // Arenas registered so far go with the caller's
+        }
+    }
+    return workers;
+}
+
+rjson_value *rjson_parse_parallel(const char *json, size_t length, unsigned int threads,
+                                  const rjson_parse_options *options)
+{
+    if (!json)
+        return NULL;
+
+    rjson_parse_options opts = {0};
+    if (options)
+        opts = *options;
+    size_t worker_count = rjson__thread_count(threads, length / RJSON_PARALLEL_MIN_CHUNK);
+    size_t max_depth = opts.max_depth ? opts.max_depth : RJSON_MAX_DEPTH;
+    if (worker_count < 2 || length < 2 * RJSON_PARALLEL_MIN_CHUNK || max_depth < 2)
+        return rjson_parse_ex(json, length, options);
+
+    // Only a root array or object can be split
+    const char *end = json + length;
+    const char *s = json;
+    if (length >= 3 && memcmp(s, "\xEF\xBB\xBF", 3) == 0)
+        s += 3;
+    s = cursor_skip_whitespace(s, end);
+    if (s == end || (*s != '[' && *s != '{'))
+        return rjson_parse_ex(json, length, options);
+
+    struct parallel_job job;
+    memset(&job, 0, sizeof(job));
+    atomic_init(&job.next_chunk, 0);
+    atomic_init(&job.failed, 0);
+    job.type = (*s == '[') ? RJSON_ARRAY : RJSON_OBJECT;
+    job.flags = opts.flags;
+    job.max_depth = max_depth - 1;
+
+    size_t max_chunks = worker_count * PARALLEL_CHUNKS_PER_WORKER;
+    size_t chunk_size = length / max_chunks;
+    if (chunk_size < RJSON_PARALLEL_MIN_CHUNK)
+        chunk_size = RJSON_PARALLEL_MIN_CHUNK;
+    job.chunks = (struct parallel_chunk *)calloc(max_chunks, sizeof(struct parallel_chunk));
+    if (job.chunks)
+        job.chunk_count = parallel_split(s, end, chunk_size, job.chunks, max_chunks);
+    if (job.chunk_count < 2)
+    {
+        free(job.chunks);
+        return rjson_parse_ex(json, length, options);
+    }
+    if (worker_count > job.chunk_count)
+        worker_count = job.chunk_count;
+
+    rjson_value *root = NULL;
+    struct parallel_worker *workers = parallel_workers_new(&job, worker_count, opts.arena);
+    if (workers)
+    {
+        rjson__run_workers(parallel_worker_main, workers, sizeof(struct parallel_worker), worker_count);
+        if (!atomic_load(&job.failed))
+            root = parallel_join(&job, opts.arena);
+        free(workers);
+    }
+
+    if (!root)
+    {
+        for (size_t c = 0; c < job.chunk_count; c++)
+            rjson_free(job.chunks[c].part);
+    }
+    free(job.chunks);
+    return root;
+}
+
+/* Appends `value` to the free list, growing it (off the initial stack block) as needed */
+static int free_list_push(rjson_value ***list, size_t *count, size_t *cap, rjson_value **local, rjson_value *value)
+{
+    if (!value || (value->flags & RJSON_VALUE_ARENA))
+        return 0;
+    if (*count == *cap)
+    {
+        size_t new_cap = *cap * 2;
+        rjson_value **grown = (rjson_value **)malloc(new_cap * sizeof(rjson_value *));
+        if (!grown)
+            return -1;
+        memcpy(grown, *list, *count * sizeof(rjson_value *));
+        if (*list != local)
+            free(*list);
+        *list = grown;
+        *cap = new_cap;
+    }
+    (*list)[(*count)++] = value;
+    return 0;
+}
+
+void rjson_free(rjson_value *value)
+{
+    if (!value || (value->flags & RJSON_VALUE_ARENA))
+        return; // Arena nodes are released by rjson_arena_reset()/rjson_arena_free()
+
+    // Pending nodes live on an explicit list rather than the C stack, so
+    // documents nested as deeply as rjson_parse_options.max_depth allows
+    // are released safely.
+    rjson_value *local[64];
+    rjson_value **list = local;
+    size_t count = 0;
+    size_t cap = 64;
+    list[count++] = value;
+
+    while (count > 0)
+    {
+        value = list[--count];
+        size_t i;
+        switch (value->type)
+        {
+        case RJSON_STRING:
+            if (!(value->flags & (RJSON_VALUE_BORROWED | RJSON_VALUE_INLINE)))
+                free(value->as.str_val);
+            break;
+        case RJSON_ARRAY:
+            for (i = 0; i < value->as.arr_val.count; ++i)
+            {
+                if (free_list_push(&list, &count, &cap, local, value->as.arr_val.elements[i]) != 0)
+                    rjson_free(value->as.arr_val.elements[i]); // Out of memory: recurse instead
+            }
+            free(value->as.arr_val.elements);
+            break;
+        case RJSON_OBJECT:
+            for (i = 0; i < value->as.obj_val.count; ++i)
+            {
+                if (value->flags & RJSON_VALUE_INTERNED)
+                    key_unref(value->as.obj_val.keys[i]);
+                else if (!(value->flags & RJSON_VALUE_BORROWED))
+                    free(value->as.obj_val.keys[i]);
+                if (free_list_push(&list, &count, &cap, local, value->as.obj_val.values[i]) != 0)
+                    rjson_free(value->as.obj_val.values[i]); // Out of memory: recurse instead
+            }
+            free(value->as.obj_val.keys);
+            free(value->as.obj_val.index);
+            free(value->as.obj_val.values);
+            break;
+        default:
+            // No dynamic memory for NULL, BOOL, NUMBER
+            break;
+        }
+        free(value);
+    }
+    if (list != local)
+        free(list);
+}
+
+const char *rjson_string_get(const rjson_value *value, size_t *out_len)
+{
+    if (!value || value->type != RJSON_STRING)
+        return NULL;
+    if (out_len)
+        *out_len = value->as.str_len;
+    return string_bytes(value);
+}
+
+/*
+ * Converts a lazily parsed number in place, once. The node is logically
+ * const to the caller; only its cached representation changes.
+ */
+static void number_materialize(const rjson_value *value)
+{
+    if (!(value->flags & RJSON_VALUE_LAZY))
+        return;
+
+    rjson_value *mut = (rjson_value *)value;
+    struct rjson__number num;
+    // The text was validated when parsed and cannot overflow
+    rjson__parse_number(mut->as.num_text, mut->as.num_text + mut->as.num_len, &num);
+    mut->flags &= ~RJSON_VALUE_LAZY;
+    mut->as.num_val = num.num_val;
+    mut->as.uint_val = num.int_bits;
+    if (num.kind == RJSON_NUMBER_INT64)
+        mut->flags |= RJSON_VALUE_INT64;
+    else if (num.kind == RJSON_NUMBER_UINT64)
+        mut->flags |= RJSON_VALUE_UINT64;
+}
+
+double rjson_number_get_double(const rjson_value *value)
+{
+    if (!value || value->type != RJSON_NUMBER)
+        return 0.0;
+    number_materialize(value);
+    return value->as.num_val;
+}
+
+rjson_number_kind rjson_number_get_kind(const rjson_value *value)
+{
+    if (!value || value->type != RJSON_NUMBER)
+        return RJSON_NUMBER_DOUBLE;
+    number_materialize(value);
+    if (value->flags & RJSON_VALUE_INT64)
+        return RJSON_NUMBER_INT64;
+    if (value->flags & RJSON_VALUE_UINT64)
+        return RJSON_NUMBER_UINT64;
+    return RJSON_NUMBER_DOUBLE;
+}
+
+int rjson_number_get_int64(const rjson_value *value, int64_t *out)
+{
+    if (!value || value->type != RJSON_NUMBER || !out)
+        return -1;
+    switch (rjson_number_get_kind(value))
+    {
+    case RJSON_NUMBER_INT64:
+        *out = value->as.int_val;
+        return 0;
+    case RJSON_NUMBER_UINT64:
+        if (value->as.uint_val > (uint64_t)INT64_MAX)
+            return -1;
+        *out = (int64_t)value->as.uint_val;
+        return 0;
+    default:
+    {
+        // Doubles qualify only if they hold an integer in range
+        double d = value->as.num_val;
+        if (!(d >= -9223372036854775808.0 && d < 9223372036854775808.0) || (double)(int64_t)d != d)
+            return -1;
+        *out = (int64_t)d;
+        return 0;
+    }
+    }
+}
+
+int rjson_number_get_uint64(const rjson_value *value, uint64_t *out)
+{
+    if (!value || value->type != RJSON_NUMBER || !out)
+        return -1;
+    switch (rjson_number_get_kind(value))
+    {
+    case RJSON_NUMBER_INT64:
+        if (value->as.int_val < 0)
+            return -1;
+        *out = (uint64_t)value->as.int_val;
+        return 0;
+    case RJSON_NUMBER_UINT64:
+        *out = value->as.uint_val;
+        return 0;
+    default:
+    {
+        double d = value->as.num_val;
+        if (!(d >= 0.0 && d < 18446744073709551616.0) || (double)(uint64_t)d != d)
+            return -1;
+        *out = (uint64_t)d;
+        return 0;
+    }
+    }
+}
+
+rjson_value *rjson_object_get_value(const rjson_value *object, const char *key)
+{
+    if (!key)
+    {
+        return NULL;
+    }
+    return rjson_object_get_value_n(object, key, strlen(key));
+}
+
+rjson_value *rjson_object_get_value_n(const rjson_value *object, const char *key, size_t key_len)
+{
+    if (!object || object->type != RJSON_OBJECT || !key || memchr(key, '\0', key_len))
+    {
+        return NULL; // Keys never contain NUL
+    }
+
+    const rjson_object *obj = &object->as.obj_val;
+    // The hash index of a wide object finds its entered members at once.
+    // A miss there is not final, as keys may have been replaced by hand since
+    // they were entered: the members are then scanned, as in small objects.
+    const struct rjson_object_index *index = obj->index;
+    if (index && index->count > 0)
+    {
+        size_t mask = index->slot_count - 1;
+        for (size_t h = (size_t)key_hash(key, key_len) & mask; index->slots[h]; h = (h + 1) & mask)
+        {
+            size_t i = index->slots[h] - 1;
+            if (i < obj->count && object_key_equals(obj, i, key, key_len))
+            {
+                return obj->values[i];
+            }
+        }
+    }
+
+    for (size_t i = 0; i < obj->count; ++i)
+    {
+        if (object_key_equals(obj, i, key, key_len))
+        {
+            return obj->values[i];
+        }
+    }
+
+    return NULL; // Key not found
+}
+
+const char *rjson_object_get_key(const rjson_value *object, size_t index, size_t *out_len)
+{
+    if (!object || object->type != RJSON_OBJECT || index >= object->as.obj_val.count)
+        return NULL;
+    if (out_len)
+        *out_len = strlen(object->as.obj_val.keys[index]);
+    return object->as.obj_val.keys[index];
+}
+
+/**
+ * @brief Adds an element to a JSON array.
+ * This is "rock solid" - if realloc fails, it frees the new element
+ * and leaves the original array unmodified.
+ *
+ * @param array The array object to add to.
+ * @param element The element to add.
+ * @return 0 on success, -1 on failure (out of memory).
+ */
+int rjson_array_add(rjson_value *array, rjson_value *element)
+{
+    if (!array || array->type != RJSON_ARRAY || !element || (array->flags & RJSON_VALUE_ARENA))
+    {
+        return -1;
+    }
+
+    size_t new_count = array->as.arr_val.count + 1;
+    rjson_value **new_elements = (rjson_value **)realloc(array->as.arr_val.elements, new_count * sizeof(rjson_value *));
+
+    if (!new_elements)
+    {
+        return -1; // Out of memory
+    }
+
+    array->as.arr_val.elements = new_elements;
+    array->as.arr_val.elements[new_count - 1] = element;
+    array->as.arr_val.count = new_count;
+
+    return 0;
+}
+
+/**
+ * @brief Appends a member without copying the key.
+ * This is "rock solid" - if realloc fails, the object is left unmodified
+ * and the caller still owns the key and value.
+ */
+static int object_append(rjson_value *object, char *key, rjson_value *value)
+{
+    // 1. Try to grow arrays
+    size_t count = object->as.obj_val.count;
+    size_t new_count = count + 1;
+    char **new_keys = (char **)realloc(object->as.obj_val.keys, new_count * sizeof(char *));
+    if (!new_keys)
+    {
+        return -1; // Out of memory
+    }
+    object->as.obj_val.keys = new_keys;
+
+    rjson_value **new_values = (rjson_value **)realloc(object->as.obj_val.values, new_count * sizeof(rjson_value *));
+    if (!new_values)
+    {
+        // new_keys succeeded, but new_values failed. The keys array is now
+        // one slot larger than needed, which is harmless: count is unchanged.
+        return -1; // Out of memory
+    }
+    object->as.obj_val.values = new_values;
+
+    // 2. Add new key and value
+    rjson_object *obj = &object->as.obj_val;
+    obj->keys[count] = key;
+    obj->values[count] = value;
+    obj->count = new_count;
+
+    // 3. Keep the hash index up to date: enter the new member while it has
+    // room, otherwise rebuild it with room for as many again. The index is
+    // optional, so failing to grow it only drops it.
+    struct rjson_object_index *index = obj->index;
+    if (index && index->count == count && count < index->capacity)
+    {
+        object_index_insert(index, obj);
+    }
+    else if (index || new_count >= RJSON_OBJECT_INDEX_MIN)
+    {
+        free(index);
+        obj->index = NULL;
+        size_t capacity = new_count * 2;
+        size_t slot_count = object_index_slots(capacity);
+        void *block = slot_count ? malloc(object_index_size(slot_count)) : NULL;
+        if (block)
+        {
+            index = object_index_init(block, capacity, slot_count);
+            while (index->count < new_count)
+                object_index_insert(index, obj);
+            obj->index = index;
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * Gives an in-situ or interned object its own copies of its keys so that
+ * keys added later can be freed uniformly. All-or-nothing on OOM.
+ */
+static int object_own_keys(rjson_value *object)
+{
+    rjson_object *obj = &object->as.obj_val;
+    char **copies = (char **)malloc((obj->count ? obj->count : 1) * sizeof(char *));
+    if (!copies)
+        return -1;
+
+    for (size_t i = 0; i < obj->count; ++i)
+    {
+        size_t len = strlen(obj->keys[i]);
+        copies[i] = (char *)malloc(len + 1);
+        if (!copies[i])
+        {
+            while (i > 0)
+                free(copies[--i]);
+            free(copies);
+            return -1;
+        }
+        memcpy(copies[i], obj->keys[i], len + 1);
+    }
+
+    if (object->flags & RJSON_VALUE_INTERNED)
+    {
+        for (size_t i = 0; i < obj->count; ++i)
+            key_unref(obj->keys[i]);
+    }
+    memcpy(obj->keys, copies, obj->count * sizeof(char *));
+    free(copies);
+    object->flags &= ~(RJSON_VALUE_BORROWED | RJSON_VALUE_INTERNED);
+    return 0;
+}
+
+/**
+ * @brief Adds a key-value pair to a JSON object.
+ * This is "rock solid" - if realloc fails, it frees the new key
+ * and leaves the original object unmodified.
+ *
+ * @param object The object to add to.
+ * @param key The string key. The function makes its own copy.
+ * @param value The value to add.
+ * @return 0 on success, -1 on failure (out of memory).
+ */
+int rjson_object_add(rjson_value *object, const char *key, rjson_value *value)
+{
+    if (!key)
+    {
+        return -1;
+    }
+    return rjson_object_add_n(object, key, strlen(key), value);
+}
+
+int rjson_object_add_n(rjson_value *object, const char *key, size_t key_len, rjson_value *value)
+{
+    if (!object || object->type != RJSON_OBJECT || !key || !value || (object->flags & RJSON_VALUE_ARENA) ||
+        memchr(key, '\0', key_len))
+    {
+        return -1; // Keys are NUL-terminated strings and cannot contain NUL
+    }
+
+    // Keys of an in-situ object point into the source buffer, and interned
+    // keys are shared; copy them before mixing in a heap-allocated key.
+    if ((object->flags & (RJSON_VALUE_BORROWED | RJSON_VALUE_INTERNED)) && object_own_keys(object) != 0)
+    {
+        return -1;
+    }
+
+    // Prepare new key
+    char *new_key = (char *)malloc(key_len + 1);
+    if (!new_key)
+    {
+        return -1;
+    }
+    memcpy(new_key, key, key_len);
+    new_key[key_len] = '\0';
+
+    if (object_append(object, new_key, value) != 0)
+    {
+        free(new_key);
+        return -1; // Out of memory
+    }
+
+    return 0;
+}
+
+// --- Serialization Implementation ---
+
+/**
+ * @brief Escapes `in_len` bytes of a string and appends them, quoted, to the
+ * string buffer. The input does not need to be NUL-terminated.
+ */
+static int escape_string(const char *in, size_t in_len, struct strbuf *sb)
+{
+    strbuf_append(sb, "\"", 1);
+
+    const char *p = in;
+    const char *start = in;
+    const char *end = in + in_len;
+
+    while (p < end)
+    {
+        char c = *p;
+        const char *replacement = NULL;
+        size_t len = 1;
+        char hex_buf[7];
 
         switch (c)
         {
@@ -935,17 +3292,74 @@ static int serialize_number(double num, struct strbuf *sb)
 
     if (len < 0 || len >= sizeof(num_buf))
     {
-        return -1; // Encoding error or buffer overflow
+        return -1; // Encoding error or buffer overflow
+    }
+
+    return strbuf_append(sb, num_buf, len);
+}
+
+static const char digit_pairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/* Writes the decimal digits of `v` so they end at `end`; returns the first digit */
+static char *format_uint64(uint64_t v, char *end)
+{
+    char *p = end;
+    // Two digits per division
+    while (v >= 100)
+    {
+        unsigned pair = (unsigned)(v % 100) * 2;
+        v /= 100;
+        p -= 2;
+        memcpy(p, digit_pairs + pair, 2);
+    }
+    if (v >= 10)
+    {
+        p -= 2;
+        memcpy(p, digit_pairs + v * 2, 2);
+    }
+    else
+    {
+        *--p = (char)('0' + v);
+    }
+    return p;
+}
+
+// Serializes an INT64/UINT64 number exactly, without snprintf
+static int serialize_integer(const rjson_value *value, struct strbuf *sb)
+{
+    char num_buf[21]; // 20 digits of UINT64_MAX, or '-' and 19 digits
+    char *end = num_buf + sizeof(num_buf);
+    int negative = 0;
+    uint64_t magnitude;
+    if (value->flags & RJSON_VALUE_UINT64)
+    {
+        magnitude = value->as.uint_val;
+    }
+    else
+    {
+        negative = value->as.int_val < 0;
+        magnitude = negative ? 0 - (uint64_t)value->as.int_val : (uint64_t)value->as.int_val;
     }
 
-    return strbuf_append(sb, num_buf, len);
+    char *p = format_uint64(magnitude, end);
+    if (negative)
+        *--p = '-';
+    return strbuf_append(sb, p, (size_t)(end - p));
 }
 
-static int serialize_value(const rjson_value *value, struct strbuf *sb, int depth)
+/* Serializes a string, number, boolean or null */
+static int serialize_scalar(const rjson_value *value, struct strbuf *sb)
 {
-    if (depth >= RJSON_MAX_DEPTH)
-        return -1; // Harden: Prevent stack overflow
-
     switch (value->type)
     {
     case RJSON_NULL:
@@ -953,53 +3367,80 @@ static int serialize_value(const rjson_value *value, struct strbuf *sb, int dept
     case RJSON_BOOL:
         return strbuf_append(sb, value->as.bool_val ? "true" : "false", value->as.bool_val ? 4 : 5);
     case RJSON_NUMBER:
+        if (value->flags & RJSON_VALUE_LAZY)
+            return strbuf_append(sb, value->as.num_text, value->as.num_len); // Original text, verbatim
+        if (value->flags & (RJSON_VALUE_INT64 | RJSON_VALUE_UINT64))
+            return serialize_integer(value, sb);
         return serialize_number(value->as.num_val, sb);
     case RJSON_STRING:
-        return escape_string(value->as.str_val, sb);
+        return escape_string(string_bytes(value), value->as.str_len, sb);
+    default:
+        return -1; // Containers are handled by serialize_value()
+    }
+}
 
-    case RJSON_ARRAY:
+/*
+ * Serializes any value. Open containers are kept on an explicit stack
+ * (see struct walk_stack), so every tree the parser can build, at any
+ * rjson_parse_options.max_depth, can be written back.
+ */
+static int serialize_value(const rjson_value *value, struct strbuf *sb)
+{
+    struct walk_stack st;
+    walk_init(&st);
+    int rc = 0;
+    for (;;)
     {
-        if (strbuf_append(sb, "[", 1) != 0)
-            return -1;
-        for (size_t i = 0; i < value->as.arr_val.count; ++i)
+        // Write `value`, or open it
+        if (value->type == RJSON_ARRAY || value->type == RJSON_OBJECT)
         {
-            if (i > 0)
+            if (strbuf_append(sb, value->type == RJSON_ARRAY ? "[" : "{", 1) != 0 || walk_push(&st, value) != 0)
             {
-                if (strbuf_append(sb, ",", 1) != 0)
-                    return -1;
+                rc = -1;
+                break;
             }
-            if (serialize_value(value->as.arr_val.elements[i], sb, depth + 1) != 0)
-                return -1;
         }
-        return strbuf_append(sb, "]", 1);
-    }
+        else if (serialize_scalar(value, sb) != 0)
+        {
+            rc = -1;
+            break;
+        }
 
-    case RJSON_OBJECT:
-    {
-        if (strbuf_append(sb, "{", 1) != 0)
-            return -1;
-        for (size_t i = 0; i < value->as.obj_val.count; ++i)
+        // Move on to the next child of the innermost open container,
+        // closing the containers that have none left
+        value = NULL;
+        while (st.depth > 0 && !value)
         {
-            if (i > 0)
+            struct walk_frame *frame = &st.frames[st.depth - 1];
+            const rjson_value *container = frame->container;
+            size_t i = frame->next;
+            if (i == walk_child_count(container))
             {
-                if (strbuf_append(sb, ",", 1) != 0)
-                    return -1;
+                if (strbuf_append(sb, container->type == RJSON_ARRAY ? "]" : "}", 1) != 0)
+                    rc = -1;
+                st.depth--;
+                if (rc != 0)
+                    break;
+                continue;
             }
-            // Serialize key (which is always a string)
-            if (escape_string(value->as.obj_val.keys[i], sb) != 0)
-                return -1;
-
-            if (strbuf_append(sb, ":", 1) != 0)
-                return -1;
-
-            // Serialize value
-            if (serialize_value(value->as.obj_val.values[i], sb, depth + 1) != 0)
-                return -1;
+            frame->next++;
+            if (i > 0 && strbuf_append(sb, ",", 1) != 0)
+                rc = -1;
+            if (rc == 0 && container->type == RJSON_OBJECT)
+            {
+                const rjson_object *obj = &container->as.obj_val;
+                if (escape_string(obj->keys[i], strlen(obj->keys[i]), sb) != 0 || strbuf_append(sb, ":", 1) != 0)
+                    rc = -1;
+            }
+            if (rc != 0)
+                break;
+            value = walk_child(container, i);
         }
-        return strbuf_append(sb, "}", 1);
-    }
+        if (rc != 0 || !value)
+            break;
     }
-    return -1; // Unreachable
+    walk_release(&st);
+    return rc;
 }
 
 int rjson_serialize(const rjson_value *value, char **out_string, size_t *out_length)
@@ -1015,7 +3456,7 @@ int rjson_serialize(const rjson_value *value, char **out_string, size_t *out_len
         return -1; // Out of memory
     }
 
-    if (serialize_value(value, &sb, 0) != 0)
+    if (serialize_value(value, &sb) != 0)
     {
         strbuf_free(&sb);
         return -1; // Serialization error
@@ -1030,9 +3471,543 @@ int rjson_serialize(const rjson_value *value, char **out_string, size_t *out_len
     return 0;
 }
 
+// --- Tape Documents ---
+
+/*
+ * Tape words carry a tag in the top byte and a 56-bit payload:
+ *   TAPE_NULL/TRUE/FALSE         no payload
+ *   TAPE_DOUBLE/INT64/UINT64     no payload; the next word holds the bits
+ *   TAPE_STRING/KEY              offset of the string in `strings`
+ *   TAPE_ARRAY/OBJECT            index just past the matching end word
+ *   TAPE_ARRAY_END/OBJECT_END    number of elements (members)
+ * A string is stored as its size_t length, its bytes and a NUL terminator.
+ */
+enum tape_tag
+{
+    TAPE_NULL = 'n',
+    TAPE_TRUE = 't',
+    TAPE_FALSE = 'f',
+    TAPE_DOUBLE = 'd',
+    TAPE_INT64 = 'l',
+    TAPE_UINT64 = 'u',
+    TAPE_STRING = '"',
+    TAPE_KEY = ':',
+    TAPE_ARRAY = '[',
+    TAPE_ARRAY_END = ']',
+    TAPE_OBJECT = '{',
+    TAPE_OBJECT_END = '}'
+};
+
+#define TAPE_TAG_SHIFT 56
+#define TAPE_PAYLOAD_MASK ((UINT64_C(1) << TAPE_TAG_SHIFT) - 1)
+
+struct rjson_tape
+{
+    uint64_t *words;
+    size_t count;
+    size_t capacity;
+    char *strings;
+    size_t strings_len;
+    size_t strings_cap;
+};
+
+/* Tape under construction, fed by the SAX driver */
+struct tape_builder
+{
+    rjson_tape *tape;
+    size_t *open; // Tape index of each open container, innermost last
+    size_t *children; // Elements (members) seen so far in each open container
+    size_t depth;
+    size_t cap;
+};
+
+static enum tape_tag tape_tag_at(const rjson_tape *tape, size_t index)
+{
+    return (enum tape_tag)(tape->words[index] >> TAPE_TAG_SHIFT);
+}
+
+static uint64_t tape_payload_at(const rjson_tape *tape, size_t index)
+{
+    return tape->words[index] & TAPE_PAYLOAD_MASK;
+}
+
+/* Appends a raw word; returns its index, or (size_t)-1 on OOM */
+static size_t tape_append_word(rjson_tape *tape, uint64_t word)
+{
+    if (tape->count == tape->capacity)
+    {
+        size_t cap = tape->capacity * 2;
+        uint64_t *grown = (uint64_t *)realloc(tape->words, cap * sizeof(uint64_t));
+        if (!grown)
+            return (size_t)-1;
+        tape->words = grown;
+        tape->capacity = cap;
+    }
+    tape->words[tape->count] = word;
+    return tape->count++;
+}
+
+/* Appends a tagged word; returns its index, or (size_t)-1 on OOM */
+static size_t tape_append(rjson_tape *tape, enum tape_tag tag, uint64_t payload)
+{
+    return tape_append_word(tape, ((uint64_t)tag << TAPE_TAG_SHIFT) | payload);
+}
+
+/* Counts a new element (or, for `is_key`, member) of the innermost open container */
+static void tape_count_child(struct tape_builder *b, int is_key)
+{
+    if (b->depth > 0 && (tape_tag_at(b->tape, b->open[b->depth - 1]) == TAPE_OBJECT) == is_key)
+        b->children[b->depth - 1]++;
+}
+
+static int tape_on_scalar(struct tape_builder *b, enum tape_tag tag)
+{
+    tape_count_child(b, 0);
+    return tape_append(b->tape, tag, 0) == (size_t)-1 ? RJSON_SAX_ABORT : RJSON_SAX_CONTINUE;
+}
+
+static int tape_on_string_word(struct tape_builder *b, enum tape_tag tag, const char *str, size_t len)
+{
+    rjson_tape *tape = b->tape;
+    tape_count_child(b, tag == TAPE_KEY);
+    size_t need = sizeof(size_t) + len + 1;
+    if (tape->strings_cap - tape->strings_len < need)
+    {
+        size_t cap = tape->strings_cap * 2;
+        while (cap - tape->strings_len < need)
+            cap *= 2;
+        char *grown = (char *)realloc(tape->strings, cap);
+        if (!grown)
+            return RJSON_SAX_ABORT;
+        tape->strings = grown;
+        tape->strings_cap = cap;
+    }
+    size_t offset = tape->strings_len;
+    memcpy(tape->strings + offset, &len, sizeof(size_t));
+    memcpy(tape->strings + offset + sizeof(size_t), str, len);
+    tape->strings[offset + sizeof(size_t) + len] = '\0';
+    tape->strings_len += need;
+    return tape_append(tape, tag, offset) == (size_t)-1 ? RJSON_SAX_ABORT : RJSON_SAX_CONTINUE;
+}
+
+static int tape_on_open(struct tape_builder *b, enum tape_tag tag)
+{
+    tape_count_child(b, 0);
+    if (b->depth == b->cap)
+    {
+        size_t cap = b->cap ? b->cap * 2 : 32;
+        size_t *open = (size_t *)realloc(b->open, cap * sizeof(size_t));
+        if (open)
+            b->open = open;
+        size_t *children = open ? (size_t *)realloc(b->children, cap * sizeof(size_t)) : NULL;
+        if (!children)
+            return RJSON_SAX_ABORT;
+        b->children = children;
+        b->cap = cap;
+    }
+    size_t index = tape_append(b->tape, tag, 0); // End patched in on close
+    if (index == (size_t)-1)
+        return RJSON_SAX_ABORT;
+    b->open[b->depth] = index;
+    b->children[b->depth] = 0;
+    b->depth++;
+    return RJSON_SAX_CONTINUE;
+}
+
+static int tape_on_close(struct tape_builder *b, enum tape_tag tag)
+{
+    b->depth--;
+    if (tape_append(b->tape, tag, b->children[b->depth]) == (size_t)-1)
+        return RJSON_SAX_ABORT;
+    b->tape->words[b->open[b->depth]] |= (uint64_t)b->tape->count;
+    return RJSON_SAX_CONTINUE;
+}
+
+static int tape_start_object(void *ctx)
+{
+    return tape_on_open((struct tape_builder *)ctx, TAPE_OBJECT);
+}
+
+static int tape_end_object(void *ctx)
+{
+    return tape_on_close((struct tape_builder *)ctx, TAPE_OBJECT_END);
+}
+
+static int tape_start_array(void *ctx)
+{
+    return tape_on_open((struct tape_builder *)ctx, TAPE_ARRAY);
+}
+
+static int tape_end_array(void *ctx)
+{
+    return tape_on_close((struct tape_builder *)ctx, TAPE_ARRAY_END);
+}
+
+static int tape_key(void *ctx, const char *str, size_t len)
+{
+    return tape_on_string_word((struct tape_builder *)ctx, TAPE_KEY, str, len);
+}
+
+static int tape_string(void *ctx, const char *str, size_t len)
+{
+    return tape_on_string_word((struct tape_builder *)ctx, TAPE_STRING, str, len);
+}
+
+static int tape_number(void *ctx, const rjson_value *number)
+{
+    struct tape_builder *b = (struct tape_builder *)ctx;
+    rjson_number_kind kind = rjson_number_get_kind(number);
+    enum tape_tag tag = kind == RJSON_NUMBER_INT64 ? TAPE_INT64 : kind == RJSON_NUMBER_UINT64 ? TAPE_UINT64 : TAPE_DOUBLE;
+    uint64_t bits = number->as.uint_val;
+    if (tag == TAPE_DOUBLE)
+        memcpy(&bits, &number->as.num_val, sizeof(bits));
+    if (tape_on_scalar(b, tag) != RJSON_SAX_CONTINUE || tape_append_word(b->tape, bits) == (size_t)-1)
+        return RJSON_SAX_ABORT;
+    return RJSON_SAX_CONTINUE;
+}
+
+static int tape_boolean(void *ctx, int value)
+{
+    return tape_on_scalar((struct tape_builder *)ctx, value ? TAPE_TRUE : TAPE_FALSE);
+}
+
+static int tape_null(void *ctx)
+{
+    return tape_on_scalar((struct tape_builder *)ctx, TAPE_NULL);
+}
+
+rjson_tape *rjson_tape_parse(const char *json, size_t length, const rjson_parse_options *options)
+{
+    if (!json)
+        return NULL;
+
+    rjson_tape *tape = (rjson_tape *)calloc(1, sizeof(rjson_tape));
+    if (!tape)
+        return NULL;
+    // Rough first guesses; both buffers double as needed
+    tape->capacity = length / 4 + 16;
+    tape->strings_cap = length / 2 + 64;
+    tape->words = (uint64_t *)malloc(tape->capacity * sizeof(uint64_t));
+    tape->strings = (char *)malloc(tape->strings_cap);
+
+    static const rjson_sax_handler handler = {
+        .start_object = tape_start_object,
+        .end_object = tape_end_object,
+        .start_array = tape_start_array,
+        .end_array = tape_end_array,
+        .key = tape_key,
+        .string = tape_string,
+        .number = tape_number,
+        .boolean = tape_boolean,
+        .null = tape_null,
+    };
+    rjson_parse_options opts = {0};
+    if (options)
+        opts = *options;
+    opts.flags &= ~RJSON_PARSE_LAZY_NUMBERS; // Every number is converted onto the tape anyway
+
+    struct tape_builder b = {0};
+    b.tape = tape;
+    int rc = -1;
+    if (tape->words && tape->strings)
+        rc = rjson_sax_parse(json, length, &handler, &b, &opts);
+    free(b.open);
+    free(b.children);
+    if (rc != 0)
+    {
+        rjson_tape_free(tape);
+        return NULL;
+    }
+    return tape;
+}
+
+void rjson_tape_free(rjson_tape *tape)
+{
+    if (!tape)
+        return;
+    free(tape->words);
+    free(tape->strings);
+    free(tape);
+}
+
+/* Index just past the value at `index`, in O(1) */
+static size_t tape_skip(const rjson_tape *tape, size_t index)
+{
+    switch (tape_tag_at(tape, index))
+    {
+    case TAPE_ARRAY:
+    case TAPE_OBJECT:
+        return (size_t)tape_payload_at(tape, index);
+    case TAPE_DOUBLE:
+    case TAPE_INT64:
+    case TAPE_UINT64:
+        return index + 2;
+    default:
+        return index + 1;
+    }
+}
+
+/* Returns nonzero if `index` is on the tape */
+static int tape_valid(const rjson_tape *tape, size_t index)
+{
+    return tape && index < tape->count;
+}
+
+rjson_type rjson_tape_get_type(const rjson_tape *tape, size_t index)
+{
+    if (!tape_valid(tape, index))
+        return RJSON_NULL;
+    switch (tape_tag_at(tape, index))
+    {
+    case TAPE_TRUE:
+    case TAPE_FALSE:
+        return RJSON_BOOL;
+    case TAPE_DOUBLE:
+    case TAPE_INT64:
+    case TAPE_UINT64:
+        return RJSON_NUMBER;
+    case TAPE_STRING:
+    case TAPE_KEY:
+        return RJSON_STRING;
+    case TAPE_ARRAY:
+        return RJSON_ARRAY;
+    case TAPE_OBJECT:
+        return RJSON_OBJECT;
+    default:
+        return RJSON_NULL;
+    }
+}
+
+/* Returns nonzero if `index` holds an array or object */
+static int tape_is_container(const rjson_tape *tape, size_t index)
+{
+    if (!tape_valid(tape, index))
+        return 0;
+    enum tape_tag tag = tape_tag_at(tape, index);
+    return tag == TAPE_ARRAY || tag == TAPE_OBJECT;
+}
+
+size_t rjson_tape_count(const rjson_tape *tape, size_t index)
+{
+    if (!tape_is_container(tape, index))
+        return 0;
+    return (size_t)tape_payload_at(tape, tape_skip(tape, index) - 1); // Kept on the end word
+}
+
+size_t rjson_tape_first(const rjson_tape *tape, size_t index)
+{
+    if (!tape_is_container(tape, index) || tape_skip(tape, index) == index + 2)
+        return 0; // Not a container, or empty
+    return index + 1;
+}
+
+size_t rjson_tape_next(const rjson_tape *tape, size_t index)
+{
+    if (!tape_valid(tape, index))
+        return 0;
+    size_t next = tape_tag_at(tape, index) == TAPE_KEY ? tape_skip(tape, index + 1) : tape_skip(tape, index);
+    if (next >= tape->count)
+        return 0;
+    enum tape_tag tag = tape_tag_at(tape, next);
+    return (tag == TAPE_ARRAY_END || tag == TAPE_OBJECT_END) ? 0 : next;
+}
+
+size_t rjson_tape_array_get(const rjson_tape *tape, size_t array, size_t position)
+{
+    if (!tape_valid(tape, array) || tape_tag_at(tape, array) != TAPE_ARRAY)
+        return 0;
+    size_t index = rjson_tape_first(tape, array);
+    while (index && position--)
+        index = rjson_tape_next(tape, index);
+    return index;
+}
+
+const char *rjson_tape_string_get(const rjson_tape *tape, size_t index, size_t *out_len)
+{
+    if (!tape_valid(tape, index))
+        return NULL;
+    enum tape_tag tag = tape_tag_at(tape, index);
+    if (tag != TAPE_STRING && tag != TAPE_KEY)
+        return NULL;
+    const char *entry = tape->strings + tape_payload_at(tape, index);
+    if (out_len)
+        memcpy(out_len, entry, sizeof(size_t));
+    return entry + sizeof(size_t);
+}
+
+size_t rjson_tape_object_get_value(const rjson_tape *tape, size_t object, const char *key)
+{
+    if (!tape_valid(tape, object) || tape_tag_at(tape, object) != TAPE_OBJECT || !key)
+        return 0;
+    size_t key_len = strlen(key);
+    for (size_t index = rjson_tape_first(tape, object); index; index = rjson_tape_next(tape, index))
+    {
+        size_t len;
+        const char *name = rjson_tape_string_get(tape, index, &len);
+        if (len == key_len && memcmp(name, key, len) == 0)
+            return index + 1;
+    }
+    return 0; // Key not found
+}
+
+int rjson_tape_bool_get(const rjson_tape *tape, size_t index)
+{
+    return tape_valid(tape, index) && tape_tag_at(tape, index) == TAPE_TRUE;
+}
+
+/*
+ * Loads the number at `index` into a temporary node, so the tree's number
+ * getters and serializer apply unchanged. Returns 0, or -1 if it is not a number.
+ */
+static int tape_load_number(const rjson_tape *tape, size_t index, rjson_value *out)
+{
+    if (!tape_valid(tape, index))
+        return -1;
+    enum tape_tag tag = tape_tag_at(tape, index);
+    if (tag != TAPE_DOUBLE && tag != TAPE_INT64 && tag != TAPE_UINT64)
+        return -1;
+    uint64_t bits = tape->words[index + 1];
+    memset(out, 0, sizeof(*out));
+    out->type = RJSON_NUMBER;
+    out->as.uint_val = bits;
+    if (tag == TAPE_INT64)
+    {
+        out->flags = RJSON_VALUE_INT64;
+        out->as.num_val = (double)(int64_t)bits;
+    }
+    else if (tag == TAPE_UINT64)
+    {
+        out->flags = RJSON_VALUE_UINT64;
+        out->as.num_val = (double)bits;
+    }
+    else
+    {
+        memcpy(&out->as.num_val, &bits, sizeof(bits));
+    }
+    return 0;
+}
+
+double rjson_tape_number_get_double(const rjson_tape *tape, size_t index)
+{
+    rjson_value num;
+    return tape_load_number(tape, index, &num) == 0 ? num.as.num_val : 0.0;
+}
+
+rjson_number_kind rjson_tape_number_get_kind(const rjson_tape *tape, size_t index)
+{
+    rjson_value num;
+    return tape_load_number(tape, index, &num) == 0 ? rjson_number_get_kind(&num) : RJSON_NUMBER_DOUBLE;
+}
+
+int rjson_tape_number_get_int64(const rjson_tape *tape, size_t index, int64_t *out)
+{
+    rjson_value num;
+    return tape_load_number(tape, index, &num) == 0 ? rjson_number_get_int64(&num, out) : -1;
+}
+
+int rjson_tape_number_get_uint64(const rjson_tape *tape, size_t index, uint64_t *out)
+{
+    rjson_value num;
+    return tape_load_number(tape, index, &num) == 0 ? rjson_number_get_uint64(&num, out) : -1;
+}
+
+/*
+ * Writes the whole tape in one pass, front to back. A comma goes before
+ * every value or key except the first of a container and a member's value.
+ */
+static int tape_serialize(const rjson_tape *tape, struct strbuf *sb)
+{
+    int comma = 0;
+    for (size_t i = 0; i < tape->count; i++)
+    {
+        enum tape_tag tag = tape_tag_at(tape, i);
+        if (tag == TAPE_ARRAY_END || tag == TAPE_OBJECT_END)
+        {
+            if (strbuf_append(sb, tag == TAPE_ARRAY_END ? "]" : "}", 1) != 0)
+                return -1;
+            comma = 1;
+            continue;
+        }
+        if (comma && strbuf_append(sb, ",", 1) != 0)
+            return -1;
+        comma = 1;
+
+        int rc;
+        switch (tag)
+        {
+        case TAPE_NULL:
+            rc = strbuf_append(sb, "null", 4);
+            break;
+        case TAPE_TRUE:
+            rc = strbuf_append(sb, "true", 4);
+            break;
+        case TAPE_FALSE:
+            rc = strbuf_append(sb, "false", 5);
+            break;
+        case TAPE_STRING:
+        case TAPE_KEY:
+        {
+            size_t len;
+            const char *str = rjson_tape_string_get(tape, i, &len);
+            rc = escape_string(str, len, sb);
+            if (rc == 0 && tag == TAPE_KEY)
+            {
+                rc = strbuf_append(sb, ":", 1);
+                comma = 0;
+            }
+            break;
+        }
+        case TAPE_ARRAY:
+        case TAPE_OBJECT:
+            rc = strbuf_append(sb, tag == TAPE_ARRAY ? "[" : "{", 1);
+            comma = 0;
+            break;
+        default:
+        {
+            rjson_value num;
+            tape_load_number(tape, i, &num);
+            rc = serialize_scalar(&num, sb);
+            i++; // Past the bits word
+            break;
+        }
+        }
+        if (rc != 0)
+            return -1;
+    }
+    return 0;
+}
+
+int rjson_tape_serialize(const rjson_tape *tape, char **out_string, size_t *out_len)
+{
+    if (!tape || !out_string)
+        return -1;
+
+    // The strings plus a few bytes of punctuation per word is a close estimate
+    struct strbuf sb;
+    if (strbuf_init(&sb, tape->strings_len + tape->count * 4 + 64) != 0)
+        return -1;
+    if (tape_serialize(tape, &sb) != 0)
+    {
+        strbuf_free(&sb);
+        return -1;
+    }
+    *out_string = sb.buffer;
+    if (out_len)
+        *out_len = sb.length;
+    return 0;
+}
+
 // --- Pretty Print Implementation ---
 
-static void rjson_print_internal(const rjson_value *value, int indent)
+/* Prints `count` levels of indentation */
+static void print_indent(size_t count)
+{
+    for (size_t j = 0; j < count; ++j)
+        printf("  ");
+}
+
+/* Prints a string, number, boolean or null (NULL prints as null) */
+static void print_scalar(const rjson_value *value)
 {
     if (!value)
     {
@@ -1049,52 +4024,72 @@ static void rjson_print_internal(const rjson_value *value, int indent)
         printf(value->as.bool_val ? "true" : "false");
         break;
     case RJSON_NUMBER:
-        // %g is fine for printing, as it's for humans
-        printf("%g", value->as.num_val);
+        // %g is fine for printing, as it's for humans; integers stay exact
+        if (value->flags & RJSON_VALUE_LAZY)
+            printf("%.*s", (int)value->as.num_len, value->as.num_text);
+        else if (value->flags & RJSON_VALUE_INT64)
+            printf("%lld", (long long)value->as.int_val);
+        else if (value->flags & RJSON_VALUE_UINT64)
+            printf("%llu", (unsigned long long)value->as.uint_val);
+        else
+            printf("%g", value->as.num_val);
         break;
     case RJSON_STRING:
         // Print simple, non-escaped string for readability
-        printf("\"%s\"", value->as.str_val);
+        printf("\"%.*s\"", (int)value->as.str_len, string_bytes(value));
         break;
-    case RJSON_ARRAY:
-        printf("[\n");
-        for (size_t i = 0; i < value->as.arr_val.count; ++i)
+    default:
+        break; // Containers are handled by rjson_print()
+    }
+}
+
+/*
+ * Prints a tree with an explicit container stack, like serialize_value(),
+ * so deep documents do not exhaust the C stack. Printing stops early if
+ * that stack cannot grow.
+ */
+void rjson_print(const rjson_value *value, int indent)
+{
+    struct walk_stack st;
+    walk_init(&st);
+    size_t base = indent > 0 ? (size_t)indent : 0;
+    for (;;)
+    {
+        if (value && (value->type == RJSON_ARRAY || value->type == RJSON_OBJECT))
         {
-            for (int j = 0; j < indent + 1; ++j)
-                printf("  ");
-            rjson_print_internal(value->as.arr_val.elements[i], indent + 1);
-            if (i < value->as.arr_val.count - 1)
-            {
-                printf(",");
-            }
-            printf("\n");
+            printf(value->type == RJSON_ARRAY ? "[\n" : "{\n");
+            if (walk_push(&st, value) != 0)
+                break; // Out of memory
         }
-        for (int j = 0; j < indent; ++j)
-            printf("  ");
-        printf("]");
-        break;
-    case RJSON_OBJECT:
-        printf("{\n");
-        for (size_t i = 0; i < value->as.obj_val.count; ++i)
+        else
+        {
+            print_scalar(value);
+        }
+
+        // Move on to the next child, closing the finished containers
+        int more = 0;
+        while (st.depth > 0 && !more)
         {
-            for (int j = 0; j < indent + 1; ++j)
-                printf("  ");
-            printf("\"%s\": ", value->as.obj_val.keys[i]);
-            rjson_print_internal(value->as.obj_val.values[i], indent + 1);
-            if (i < value->as.obj_val.count - 1)
+            struct walk_frame *frame = &st.frames[st.depth - 1];
+            const rjson_value *container = frame->container;
+            size_t count = walk_child_count(container);
+            if (frame->next > 0)
+                printf(frame->next < count ? ",\n" : "\n"); // After the previous child
+            if (frame->next == count)
             {
-                printf(",");
+                print_indent(base + st.depth - 1);
+                printf(container->type == RJSON_ARRAY ? "]" : "}");
+                st.depth--;
+                continue;
             }
-            printf("\n");
+            print_indent(base + st.depth);
+            if (container->type == RJSON_OBJECT)
+                printf("\"%s\": ", container->as.obj_val.keys[frame->next]);
+            value = walk_child(container, frame->next++);
+            more = 1;
         }
-        for (int j = 0; j < indent; ++j)
-            printf("  ");
-        printf("}");
-        break;
+        if (!more)
+            break;
     }
-}
-
-void rjson_print(const rjson_value *value, int indent)
-{
-    rjson_print_internal(value, indent);
+    walk_release(&st);
 }
\ No newline at end of file
@@ -0,0 +1,149 @@
+#include "rjson_internal.h"
+#include <stdlib.h>
+
+#define RJSON_ARENA_DEFAULT_CHUNK (64 * 1024)
+#define RJSON_ARENA_ALIGN 8
+
+/*
+ * Arena memory is a singly linked list of chunks. Allocation bumps `used`
+ * in the current chunk; reset rewinds every chunk so the memory is reused
+ * by the next document instead of going back to malloc.
+ */
+struct rjson_arena_chunk
+{
+    struct rjson_arena_chunk *next;
+    size_t capacity;
+    size_t used;
+};
+
+/* A release callback, itself allocated from the arena */
+struct rjson_arena_cleanup
+{
+    struct rjson_arena_cleanup *next;
+    void (*release)(void *ctx);
+    void *ctx;
+};
+
+struct rjson_arena
+{
+    struct rjson_arena_chunk *first;
+    struct rjson_arena_chunk *current;
+    struct rjson_arena_cleanup *cleanups; // Most recent first
+    size_t chunk_size;
+};
+
+/* Chunk payload starts right after the (8-byte aligned) header */
+static char *chunk_data(struct rjson_arena_chunk *chunk)
+{
+    return (char *)(chunk + 1);
+}
+
+static size_t align_size(size_t size)
+{
+    return (size + (RJSON_ARENA_ALIGN - 1)) & ~(size_t)(RJSON_ARENA_ALIGN - 1);
+}
+
+static struct rjson_arena_chunk *chunk_new(size_t capacity)
+{
+    struct rjson_arena_chunk *chunk = (struct rjson_arena_chunk *)malloc(sizeof(struct rjson_arena_chunk) + capacity);
+    if (!chunk)
+        return NULL;
+    chunk->next = NULL;
+    chunk->capacity = capacity;
+    chunk->used = 0;
+    return chunk;
+}
+
+rjson_arena *rjson_arena_new(size_t chunk_size)
+{
+    rjson_arena *arena = (rjson_arena *)calloc(1, sizeof(rjson_arena));
+    if (!arena)
+        return NULL;
+    arena->chunk_size = chunk_size ? align_size(chunk_size) : RJSON_ARENA_DEFAULT_CHUNK;
+    return arena;
+}
+
+void *rjson__arena_alloc(rjson_arena *arena, size_t size)
+{
+    size = align_size(size ? size : 1);
+
+    struct rjson_arena_chunk *chunk = arena->current;
+    if (chunk && chunk->capacity - chunk->used >= size)
+    {
+        void *ptr = chunk_data(chunk) + chunk->used;
+        chunk->used += size;
+        return ptr;
+    }
+
+    // Reuse the chunk that follows (left over from before a reset) if it fits,
+    // otherwise splice a fresh one in after the current chunk.
+    struct rjson_arena_chunk *next = chunk ? chunk->next : arena->first;
+    if (!next || next->capacity < size)
+    {
+        size_t capacity = size > arena->chunk_size ? size : arena->chunk_size;
+        struct rjson_arena_chunk *fresh = chunk_new(capacity);
+        if (!fresh)
+            return NULL;
+        fresh->next = next;
+        if (chunk)
+            chunk->next = fresh;
+        else
+            arena->first = fresh;
+        next = fresh;
+    }
+
+    arena->current = next;
+    next->used = size;
+    return chunk_data(next);
+}
+
+int rjson_arena_add_cleanup(rjson_arena *arena, void (*release)(void *ctx), void *ctx)
+{
+    if (!arena || !release)
+        return -1;
+    struct rjson_arena_cleanup *cleanup = (struct rjson_arena_cleanup *)rjson__arena_alloc(arena, sizeof(*cleanup));
+    if (!cleanup)
+        return -1;
+    cleanup->release = release;
+    cleanup->ctx = ctx;
+    cleanup->next = arena->cleanups;
+    arena->cleanups = cleanup;
+    return 0;
+}
+
+/* Runs and forgets the registered callbacks; their records die with the chunks */
+static void run_cleanups(rjson_arena *arena)
+{
+    struct rjson_arena_cleanup *cleanup = arena->cleanups;
+    arena->cleanups = NULL;
+    while (cleanup)
+    {
+        cleanup->release(cleanup->ctx);
+        cleanup = cleanup->next;
+    }
+}
+
+void rjson_arena_reset(rjson_arena *arena)
+{
+    if (!arena)
+        return;
+    run_cleanups(arena);
+    for (struct rjson_arena_chunk *chunk = arena->first; chunk; chunk = chunk->next)
+        chunk->used = 0;
+    arena->current = arena->first;
+}
+
+void rjson_arena_free(rjson_arena *arena)
+{
+    if (!arena)
+        return;
+    run_cleanups(arena);
+    struct rjson_arena_chunk *chunk = arena->first;
+    while (chunk)
+    {
+        struct rjson_arena_chunk *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    free(arena);
+}
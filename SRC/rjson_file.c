@@ -0,0 +1,171 @@
+#define _POSIX_C_SOURCE 200809L // mmap(), posix_madvise()
+
+#include "rjson_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+ * Parsing straight from a file. Where mmap() is available the file is
+ * mapped read-only and parsed in place, with no read() into a buffer;
+ * elsewhere it is read into one heap buffer.
+ */
+
+#if defined(__unix__) || defined(__APPLE__)
+#define RJSON_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define RJSON_MMAP 0
+#endif
+
+/* The input of a parse, released once no node references it any more */
+struct file_input
+{
+    char *data;
+    size_t length;
+    int mapped; // From mmap() rather than malloc()
+};
+
+static void file_input_release(void *ctx)
+{
+    struct file_input *input = (struct file_input *)ctx;
+#if RJSON_MMAP
+    if (input->mapped)
+    {
+        munmap(input->data, input->length);
+        return;
+    }
+#endif
+    free(input->data);
+}
+
+/*
+ * Maps (or reads) the whole file into `input`. Returns 0, or -1 if the file
+ * cannot be opened or read, or on OOM. An empty file yields no data.
+ */
+static int file_input_open(const char *path, struct file_input *input)
+{
+    input->data = NULL;
+    input->length = 0;
+    input->mapped = 0;
+
+#if RJSON_MMAP
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return -1;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < 0 || (unsigned long long)st.st_size > SIZE_MAX)
+    {
+        close(fd);
+        return -1;
+    }
+    if (st.st_size > 0)
+    {
+        void *map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED)
+        {
+            // The parser reads the mapping front to back exactly once
+            posix_madvise(map, (size_t)st.st_size, POSIX_MADV_SEQUENTIAL);
+            posix_madvise(map, (size_t)st.st_size, POSIX_MADV_WILLNEED);
+            input->data = (char *)map;
+            input->length = (size_t)st.st_size;
+            input->mapped = 1;
+        }
+    }
+    close(fd);
+    if (input->mapped || st.st_size == 0)
+        return 0;
+    // Not mappable (e.g. a pipe or special file): read it instead
+#endif
+
+    FILE *f = fopen(path, "rb");
+    if (!f)
+        return -1;
+    size_t cap = 64 * 1024;
+    char *data = (char *)malloc(cap);
+    while (data)
+    {
+        input->length += fread(data + input->length, 1, cap - input->length, f);
+        if (input->length < cap)
+            break;
+        char *grown = (char *)realloc(data, cap * 2);
+        if (!grown)
+        {
+            free(data);
+            data = NULL;
+            break;
+        }
+        data = grown;
+        cap *= 2;
+    }
+    int failed = !data || ferror(f);
+    fclose(f);
+    if (failed)
+    {
+        free(data);
+        return -1;
+    }
+    input->data = data;
+    return 0;
+}
+
+/*
+ * Returns nonzero if RJSON_PADDING readable bytes follow the mapping: the
+ * rest of the file's last page is mapped and reads as zeros.
+ */
+static int file_input_padded(const struct file_input *input)
+{
+#if RJSON_MMAP
+    long page = sysconf(_SC_PAGESIZE);
+    if (!input->mapped || page <= 0)
+        return 0;
+    size_t tail = input->length % (size_t)page;
+    return tail != 0 && (size_t)page - tail >= RJSON_PADDING;
+#else
+    (void)input;
+    return 0;
+#endif
+}
+
+rjson_value *rjson_parse_file(const char *path, const rjson_parse_options *options)
+{
+    if (!path)
+        return NULL;
+    struct file_input input;
+    if (file_input_open(path, &input) != 0)
+        return NULL;
+
+    rjson_parse_options opts = {0};
+    if (options)
+        opts = *options;
+    if (file_input_padded(&input))
+        opts.flags |= RJSON_PARSE_PADDED;
+
+    // Views into the file need the input to outlive the tree, which only an
+    // arena can promise; heap documents get copies instead.
+    int keep_input = 0;
+    if (opts.flags & (RJSON_PARSE_ZEROCOPY | RJSON_PARSE_LAZY_NUMBERS))
+    {
+        if (opts.arena)
+            keep_input = 1;
+        else
+            opts.flags &= ~(RJSON_PARSE_ZEROCOPY | RJSON_PARSE_LAZY_NUMBERS);
+    }
+
+    rjson_value *result = rjson_parse_ex(input.data ? input.data : "", input.length, &opts);
+    if (result && keep_input)
+    {
+        struct file_input *kept = (struct file_input *)rjson__arena_alloc(opts.arena, sizeof(struct file_input));
+        if (kept)
+        {
+            *kept = input;
+            if (rjson_arena_add_cleanup(opts.arena, file_input_release, kept) == 0)
+                return result; // Released with the arena
+        }
+        result = NULL; // Out of memory: the tree cannot outlive the input
+    }
+    file_input_release(&input);
+    return result;
+}
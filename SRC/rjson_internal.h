@@ -0,0 +1,153 @@
+#ifndef RJSON_INTERNAL_H
+#define RJSON_INTERNAL_H
+
+#include "rjson.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// --- Value Flags (rjson_value.flags) ---
+
+// The node and everything it references live in an rjson_arena.
+// rjson_free() ignores such nodes; the arena releases them in bulk.
+#define RJSON_VALUE_ARENA 0x1u
+
+// The node's string data (str_val, or the keys of an object) points into a
+// caller-owned buffer (in-situ parsing) and must not be freed.
+#define RJSON_VALUE_BORROWED 0x2u
+
+// str_val is a zero-copy view of str_len bytes of the input and is NOT
+// NUL-terminated. Always set together with RJSON_VALUE_BORROWED.
+#define RJSON_VALUE_VIEW 0x4u
+
+// Number subtype (see rjson_number_kind); neither bit set means a double.
+#define RJSON_VALUE_INT64 0x8u
+#define RJSON_VALUE_UINT64 0x10u
+
+// Number not converted yet: as.num_text/num_len hold its validated source
+// text (RJSON_PARSE_LAZY_NUMBERS). Cleared on first access.
+#define RJSON_VALUE_LAZY 0x20u
+
+// The object's keys are interned (RJSON_PARSE_INTERN_KEYS): shared with the
+// other objects of the document and, on the heap, reference-counted.
+#define RJSON_VALUE_INTERNED 0x40u
+
+// The string is stored in the node's own as.str_inline, without a separate
+// allocation (RJSON_PARSE_INLINE_STRINGS); str_val is NULL.
+#define RJSON_VALUE_INLINE 0x80u
+
+// Longest string stored inline. The inline buffer fills the space the union
+// has to the right of str_val/str_len anyway, so nodes do not grow.
+#define RJSON_INLINE_STRING_MAX (sizeof(((rjson_value *)0)->as.str_inline) - 1)
+
+// rjson_object is the widest member of the value union; strings (with their
+// inline buffer) and numbers must fit in its space.
+_Static_assert(sizeof(((rjson_value *)0)->as) == sizeof(rjson_object), "rjson_value must not grow");
+
+// --- Arena (SRC/rjson_arena.c) ---
+
+/*
+ * Bump-allocates `size` bytes from the arena. The memory is aligned for any
+ * rjson_value member and is NOT zeroed. Returns NULL on OOM.
+ */
+void *rjson__arena_alloc(rjson_arena *arena, size_t size);
+
+// --- Numbers (SRC/rjson_number.c) ---
+
+/* A decoded JSON number: always a double, plus the exact value of integers */
+struct rjson__number
+{
+    rjson_number_kind kind;
+    double num_val;    // Correctly rounded, for every kind
+    uint64_t int_bits; // The int64_t/uint64_t value for integer kinds
+};
+
+/*
+ * Parses the JSON number at `s` (reading no further than `end`), independent
+ * of the locale and without allocating. Integers without fraction or
+ * exponent that fit in 64 bits are reported as RJSON_NUMBER_INT64 (or
+ * RJSON_NUMBER_UINT64 above INT64_MAX). Returns the position just past the
+ * number, or NULL if it does not follow the JSON grammar or overflows a
+ * finite double.
+ */
+const char *rjson__parse_number(const char *s, const char *end, struct rjson__number *out);
+
+/*
+ * Checks the JSON number grammar at `s` without converting anything.
+ * Returns the position just past the number or NULL, and reports whether
+ * the number has an exponent part.
+ */
+const char *rjson__scan_number(const char *s, const char *end, int *has_exponent);
+
+// --- Structural Index (SRC/rjson_simd.c) ---
+
+/*
+ * Byte offsets of every structural character of a document: { } [ ] : ,
+ * outside strings, each opening quote, and the first byte of each
+ * number/literal. positions[count] holds the input length as a sentinel.
+ */
+struct rjson__index
+{
+    uint32_t *positions;
+    size_t count;
+};
+
+/*
+ * Builds the structural index of `length` bytes of JSON (no padding or
+ * terminator required). Returns 0 on success, -1 on OOM or if the input is
+ * too long for 32-bit offsets.
+ */
+int rjson__index_build(const char *json, size_t length, struct rjson__index *index);
+
+void rjson__index_free(struct rjson__index *index);
+
+/*
+ * Skips the array or object whose opening bracket is at `json` by matching
+ * brackets outside strings, 64 bytes at a time, without validating its
+ * contents. Returns the position just past the matching closing bracket, or
+ * NULL if the input ends first. Reads no byte at or past `end`.
+ */
+const char *rjson__skip_container(const char *json, const char *end);
+
+/*
+ * Returns the length of the longest prefix of the `n` bytes at `s` that
+ * contains no '"', '\\' or control character (< 0x20), i.e. the plain run a
+ * string scanner can skip or copy wholesale. Returns `n` if there is none.
+ * Reads exactly the `n` bytes given.
+ */
+size_t rjson__string_span(const char *s, size_t n);
+
+// --- Worker Threads (SRC/rjson_thread.c) ---
+
+/*
+ * Number of workers to use for `requested` threads (0: one per online CPU),
+ * capped at a small multiple of the online CPUs and at `max_work`, the most
+ * work items the job can be cut into. Always at least 1.
+ */
+size_t rjson__thread_count(unsigned int requested, size_t max_work);
+
+/*
+ * Calls `run` on each of the `count` workers of the array at `workers`
+ * (elements of `worker_size` bytes) concurrently, and returns once all of
+ * them are done. Worker 0 runs on the calling thread. A worker whose thread
+ * cannot be started does not run at all, so callers hand out their work
+ * from a shared counter that the other workers keep draining.
+ */
+void rjson__run_workers(void *(*run)(void *), void *workers, size_t worker_size, size_t count);
+
+/* Number of trailing zero bits; `x` must be non-zero */
+static inline unsigned rjson__ctz64(uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_ctzll(x);
+#else
+    unsigned n = 0;
+    while (!(x & 1))
+    {
+        x >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+#endif // RJSON_INTERNAL_H
@@ -0,0 +1,339 @@
+#include "rjson_internal.h"
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Parallel NDJSON (JSON Lines) parsing.
+ *
+ * A raw newline can never appear inside a valid JSON string, so every '\n'
+ * byte ends a record and boundaries are found with memchr() alone. The input
+ * is cut into chunks at line boundaries, which worker threads claim from a
+ * shared counter. Two passes run over the chunks: the first counts the
+ * records of each chunk (so every record knows its index without a serial
+ * scan), the second parses them, each worker into its own arena.
+ */
+
+// Chunks per worker: enough for load balancing without much claiming overhead
+#define CHUNKS_PER_WORKER 8
+
+// Smallest nominal chunk: small inputs are cut into fewer, larger chunks
+#define CHUNK_MIN_SIZE 4096
+
+/* A run of whole lines, and the index of its first record */
+struct ndjson_chunk
+{
+    const char *begin;
+    const char *end;
+    size_t first;
+    size_t count;
+};
+
+/* State shared by all workers of one call */
+struct ndjson_job
+{
+    struct ndjson_chunk *chunks;
+    size_t chunk_count;
+    atomic_size_t next_chunk; // Next chunk to claim
+    int counting;             // First pass: count records instead of parsing them
+    rjson_parse_options parse;
+    atomic_int stop; // A callback aborted, or OOM
+
+    // Batch mode: documents[index], invalid records are NULL
+    rjson_value **documents;
+    atomic_size_t failed;
+
+    // Streaming mode
+    int (*callback)(void *ctx, size_t index, rjson_value *document);
+    void *ctx;
+};
+
+struct ndjson_worker
+{
+    struct ndjson_job *job;
+    rjson_arena *arena;
+};
+
+struct rjson_ndjson_batch
+{
+    rjson_value **documents;
+    size_t count;
+    size_t failed;
+    rjson_arena **arenas; // One per worker, owning the documents
+    size_t arena_count;
+};
+
+/* Returns nonzero if [s, end) holds only JSON whitespace */
+static int is_blank(const char *s, const char *end)
+{
+    for (; s < end; s++)
+    {
+        if (*s != ' ' && *s != '\t' && *s != '\r')
+            return 0;
+    }
+    return 1;
+}
+
+/* Returns the end of the line starting at `s` (its '\n' or `end`) */
+static const char *line_end(const char *s, const char *end)
+{
+    const char *nl = (const char *)memchr(s, '\n', (size_t)(end - s));
+    return nl ? nl : end;
+}
+
+/* Counts or parses the records of one chunk */
+static void ndjson_run_chunk(struct ndjson_job *job, struct ndjson_worker *worker, struct ndjson_chunk *chunk)
+{
+    size_t index = chunk->first;
+    rjson_parse_options options = job->parse;
+    options.arena = worker->arena;
+
+    for (const char *s = chunk->begin; s < chunk->end;)
+    {
+        if (atomic_load(&job->stop))
+            return; // Another worker's callback aborted
+        const char *eol = line_end(s, chunk->end);
+        if (!is_blank(s, eol))
+        {
+            if (job->counting)
+                chunk->count++;
+            else
+            {
+                rjson_value *doc = rjson_parse_ex(s, (size_t)(eol - s), &options);
+                if (job->callback)
+                {
+                    int rc = job->callback(job->ctx, index, doc);
+                    rjson_arena_reset(worker->arena); // Streaming runs in constant memory
+                    if (rc != 0)
+                    {
+                        atomic_store(&job->stop, 1);
+                        return;
+                    }
+                }
+                else
+                {
+                    job->documents[index] = doc;
+                    if (!doc)
+                        atomic_fetch_add(&job->failed, 1);
+                }
+                index++;
+            }
+        }
+        s = eol + 1;
+    }
+}
+
+/* Claims and processes chunks until none are left */
+static void *ndjson_worker_main(void *arg)
+{
+    struct ndjson_worker *worker = (struct ndjson_worker *)arg;
+    struct ndjson_job *job = worker->job;
+    while (!atomic_load(&job->stop))
+    {
+        size_t c = atomic_fetch_add(&job->next_chunk, 1);
+        if (c >= job->chunk_count)
+            break;
+        ndjson_run_chunk(job, worker, &job->chunks[c]);
+    }
+    return NULL;
+}
+
+/*
+ * Runs one pass over all chunks. The calling thread is worker 0; if a
+ * thread cannot be started its share is simply taken by the others.
+ */
+static void ndjson_run_pass(struct ndjson_job *job, struct ndjson_worker *workers, size_t worker_count)
+{
+    atomic_store(&job->next_chunk, 0);
+    rjson__run_workers(ndjson_worker_main, workers, sizeof(struct ndjson_worker), worker_count);
+}
+
+/*
+ * Cuts [data, data + length) into chunks of whole lines, counts the records
+ * of each chunk and assigns record indices. Returns the number of records,
+ * or (size_t)-1 on OOM.
+ */
+static size_t ndjson_prepare(struct ndjson_job *job, struct ndjson_worker *workers, size_t worker_count,
+                             const char *data, size_t length)
+{
+    size_t chunk_count = worker_count * CHUNKS_PER_WORKER;
+    if (chunk_count > length / CHUNK_MIN_SIZE + 1)
+        chunk_count = length / CHUNK_MIN_SIZE + 1;
+    job->chunks = (struct ndjson_chunk *)calloc(chunk_count, sizeof(struct ndjson_chunk));
+    if (!job->chunks)
+        return (size_t)-1;
+    job->chunk_count = chunk_count;
+
+    // A chunk starts at the first line beginning at or after its nominal offset
+    const char *end = data + length;
+    const char *prev = data;
+    for (size_t c = 0; c < chunk_count; c++)
+    {
+        const char *begin = data + (size_t)((double)length * (double)c / (double)chunk_count);
+        if (begin < prev)
+            begin = prev;
+        if (begin > data && begin < end && begin[-1] != '\n')
+        {
+            begin = line_end(begin, end);
+            if (begin < end)
+                begin++;
+        }
+        job->chunks[c].begin = begin;
+        if (c > 0)
+            job->chunks[c - 1].end = begin;
+        prev = begin;
+    }
+    job->chunks[chunk_count - 1].end = end;
+
+    job->counting = 1;
+    ndjson_run_pass(job, workers, worker_count);
+    job->counting = 0;
+
+    size_t total = 0;
+    for (size_t c = 0; c < chunk_count; c++)
+    {
+        job->chunks[c].first = total;
+        total += job->chunks[c].count;
+    }
+    return total;
+}
+
+/* Creates the workers, each with its own arena. Returns 0 or -1 on OOM. */
+static int ndjson_workers_new(struct ndjson_job *job, size_t count, struct ndjson_worker **out)
+{
+    struct ndjson_worker *workers = (struct ndjson_worker *)calloc(count, sizeof(struct ndjson_worker));
+    if (!workers)
+        return -1;
+    for (size_t i = 0; i < count; i++)
+    {
+        workers[i].job = job;
+        workers[i].arena = rjson_arena_new(0);
+        if (!workers[i].arena)
+        {
+            for (size_t j = 0; j < i; j++)
+                rjson_arena_free(workers[j].arena);
+            free(workers);
+            return -1;
+        }
+    }
+    *out = workers;
+    return 0;
+}
+
+/* Initializes a job from the caller's options */
+static void ndjson_job_init(struct ndjson_job *job, const rjson_ndjson_options *options)
+{
+    memset(job, 0, sizeof(*job));
+    atomic_init(&job->next_chunk, 0);
+    atomic_init(&job->stop, 0);
+    atomic_init(&job->failed, 0);
+    if (options)
+        job->parse = options->parse;
+}
+
+rjson_ndjson_batch *rjson_ndjson_parse(const char *data, size_t length, const rjson_ndjson_options *options)
+{
+    if (!data && length)
+        return NULL;
+    rjson_ndjson_batch *batch = (rjson_ndjson_batch *)calloc(1, sizeof(rjson_ndjson_batch));
+    if (!batch)
+        return NULL;
+
+    struct ndjson_job job;
+    ndjson_job_init(&job, options);
+    size_t worker_count = rjson__thread_count(options ? options->threads : 0, length / CHUNK_MIN_SIZE + 1);
+    struct ndjson_worker *workers = NULL;
+    if (ndjson_workers_new(&job, worker_count, &workers) != 0)
+    {
+        free(batch);
+        return NULL;
+    }
+
+    size_t count = ndjson_prepare(&job, workers, worker_count, data ? data : "", length);
+    if (count != (size_t)-1)
+    {
+        job.documents = (rjson_value **)calloc(count ? count : 1, sizeof(rjson_value *));
+        if (job.documents)
+            ndjson_run_pass(&job, workers, worker_count);
+    }
+
+    // The batch keeps the arenas, which own the documents
+    batch->arenas = (rjson_arena **)malloc(worker_count * sizeof(rjson_arena *));
+    for (size_t i = 0; i < worker_count; i++)
+    {
+        if (batch->arenas)
+            batch->arenas[i] = workers[i].arena;
+        else
+            rjson_arena_free(workers[i].arena);
+    }
+    batch->arena_count = batch->arenas ? worker_count : 0;
+    batch->documents = job.documents;
+    batch->count = count;
+    batch->failed = atomic_load(&job.failed);
+    free(workers);
+    free(job.chunks);
+
+    if (count == (size_t)-1 || !job.documents || !batch->arenas)
+    {
+        rjson_ndjson_free(batch);
+        return NULL; // Out of memory
+    }
+    return batch;
+}
+
+size_t rjson_ndjson_count(const rjson_ndjson_batch *batch)
+{
+    return batch ? batch->count : 0;
+}
+
+size_t rjson_ndjson_error_count(const rjson_ndjson_batch *batch)
+{
+    return batch ? batch->failed : 0;
+}
+
+rjson_value *rjson_ndjson_get(const rjson_ndjson_batch *batch, size_t index)
+{
+    if (!batch || index >= batch->count)
+        return NULL;
+    return batch->documents[index];
+}
+
+void rjson_ndjson_free(rjson_ndjson_batch *batch)
+{
+    if (!batch)
+        return;
+    for (size_t i = 0; i < batch->arena_count; i++)
+        rjson_arena_free(batch->arenas[i]);
+    free(batch->arenas);
+    free(batch->documents);
+    free(batch);
+}
+
+int rjson_ndjson_each(const char *data, size_t length, const rjson_ndjson_options *options,
+                      int (*callback)(void *ctx, size_t index, rjson_value *document), void *ctx)
+{
+    if ((!data && length) || !callback)
+        return -1;
+
+    struct ndjson_job job;
+    ndjson_job_init(&job, options);
+    job.callback = callback;
+    job.ctx = ctx;
+    size_t worker_count = rjson__thread_count(options ? options->threads : 0, length / CHUNK_MIN_SIZE + 1);
+    struct ndjson_worker *workers = NULL;
+    if (ndjson_workers_new(&job, worker_count, &workers) != 0)
+        return -1;
+
+    int rc = -1;
+    if (ndjson_prepare(&job, workers, worker_count, data ? data : "", length) != (size_t)-1)
+    {
+        ndjson_run_pass(&job, workers, worker_count);
+        rc = atomic_load(&job.stop) ? -1 : 0;
+    }
+
+    for (size_t i = 0; i < worker_count; i++)
+        rjson_arena_free(workers[i].arena);
+    free(workers);
+    free(job.chunks);
+    return rc;
+}
@@ -0,0 +1,527 @@
+#include "rjson_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Stage 1 of the two-stage parser: find every structural position of the
+ * input in 64-byte blocks.
+ *
+ * Each block is classified into four 64-bit masks (one bit per byte):
+ * quotes, backslashes, whitespace and operators ({ } [ ] : ,). Plain integer
+ * bit arithmetic then removes escaped quotes, computes which bytes are inside
+ * strings, and marks the start of every scalar (number/literal) run. Only the
+ * classification step is ISA-specific:
+ *   x86-64:  SSE2 (baseline), AVX2 selected at runtime
+ *   aarch64: NEON
+ *   others:  table-driven scalar loop
+ */
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <emmintrin.h>
+#define RJSON_SIMD_SSE2 1
+#if defined(__GNUC__)
+#include <immintrin.h>
+#define RJSON_SIMD_AVX2 1
+#endif
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define RJSON_SIMD_NEON 1
+#endif
+
+#define BLOCK_SIZE 64
+
+/* Per-byte classification of one block */
+struct block_masks
+{
+    uint64_t quote;
+    uint64_t backslash;
+    uint64_t whitespace;
+    uint64_t op;
+};
+
+/* Bit-level state carried from one block to the next */
+struct index_state
+{
+    uint64_t prev_odd_backslash; // 1 if the previous block ended in an odd backslash run
+    uint64_t prev_in_string;     // All ones if the previous block ended inside a string
+    uint64_t prev_scalar;        // 1 if the previous block ended inside a scalar run
+};
+
+// --- Classification Kernels ---
+
+#if !RJSON_SIMD_SSE2 && !RJSON_SIMD_NEON
+#define CLASS_QUOTE 1
+#define CLASS_BACKSLASH 2
+#define CLASS_WHITESPACE 4
+#define CLASS_OP 8
+
+static const uint8_t byte_class[256] = {
+    ['"'] = CLASS_QUOTE,
+    ['\\'] = CLASS_BACKSLASH,
+    [' '] = CLASS_WHITESPACE,
+    ['\t'] = CLASS_WHITESPACE,
+    ['\n'] = CLASS_WHITESPACE,
+    ['\r'] = CLASS_WHITESPACE,
+    ['{'] = CLASS_OP,
+    ['}'] = CLASS_OP,
+    ['['] = CLASS_OP,
+    [']'] = CLASS_OP,
+    [':'] = CLASS_OP,
+    [','] = CLASS_OP,
+};
+
+static void classify_scalar(const uint8_t *in, struct block_masks *m)
+{
+    uint64_t quote = 0, backslash = 0, whitespace = 0, op = 0;
+    for (int i = 0; i < BLOCK_SIZE; i++)
+    {
+        uint8_t c = byte_class[in[i]];
+        uint64_t bit = (uint64_t)1 << i;
+        if (c & CLASS_QUOTE)
+            quote |= bit;
+        if (c & CLASS_BACKSLASH)
+            backslash |= bit;
+        if (c & CLASS_WHITESPACE)
+            whitespace |= bit;
+        if (c & CLASS_OP)
+            op |= bit;
+    }
+    m->quote = quote;
+    m->backslash = backslash;
+    m->whitespace = whitespace;
+    m->op = op;
+}
+#endif
+
+#if RJSON_SIMD_SSE2
+/*
+ * '[' ']' '{' '}' differ from each other only in bits 0x20 and 0x02, so
+ * OR-ing 0x20 folds the brackets onto the braces: two compares for four chars.
+ */
+static void classify_sse2(const uint8_t *in, struct block_masks *m)
+{
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i lf = _mm_set1_epi8('\n');
+    const __m128i cr = _mm_set1_epi8('\r');
+    const __m128i fold = _mm_set1_epi8(0x20);
+    const __m128i lbrace = _mm_set1_epi8('{');
+    const __m128i rbrace = _mm_set1_epi8('}');
+    const __m128i colon = _mm_set1_epi8(':');
+    const __m128i comma = _mm_set1_epi8(',');
+
+    uint64_t q = 0, b = 0, w = 0, o = 0;
+    for (int i = 0; i < BLOCK_SIZE; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)(in + i));
+        __m128i folded = _mm_or_si128(v, fold);
+        __m128i ws = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, space), _mm_cmpeq_epi8(v, tab)),
+                                  _mm_or_si128(_mm_cmpeq_epi8(v, lf), _mm_cmpeq_epi8(v, cr)));
+        __m128i ops = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(folded, lbrace), _mm_cmpeq_epi8(folded, rbrace)),
+                                   _mm_or_si128(_mm_cmpeq_epi8(v, colon), _mm_cmpeq_epi8(v, comma)));
+        q |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, quote)) << i;
+        b |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, backslash)) << i;
+        w |= (uint64_t)(uint16_t)_mm_movemask_epi8(ws) << i;
+        o |= (uint64_t)(uint16_t)_mm_movemask_epi8(ops) << i;
+    }
+    m->quote = q;
+    m->backslash = b;
+    m->whitespace = w;
+    m->op = o;
+}
+#endif
+
+#if RJSON_SIMD_AVX2
+__attribute__((target("avx2"))) static void classify_avx2(const uint8_t *in, struct block_masks *m)
+{
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i space = _mm256_set1_epi8(' ');
+    const __m256i tab = _mm256_set1_epi8('\t');
+    const __m256i lf = _mm256_set1_epi8('\n');
+    const __m256i cr = _mm256_set1_epi8('\r');
+    const __m256i fold = _mm256_set1_epi8(0x20);
+    const __m256i lbrace = _mm256_set1_epi8('{');
+    const __m256i rbrace = _mm256_set1_epi8('}');
+    const __m256i colon = _mm256_set1_epi8(':');
+    const __m256i comma = _mm256_set1_epi8(',');
+
+    uint64_t q = 0, b = 0, w = 0, o = 0;
+    for (int i = 0; i < BLOCK_SIZE; i += 32)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(in + i));
+        __m256i folded = _mm256_or_si256(v, fold);
+        __m256i ws = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, space), _mm256_cmpeq_epi8(v, tab)),
+                                     _mm256_or_si256(_mm256_cmpeq_epi8(v, lf), _mm256_cmpeq_epi8(v, cr)));
+        __m256i ops = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(folded, lbrace), _mm256_cmpeq_epi8(folded, rbrace)),
+                                      _mm256_or_si256(_mm256_cmpeq_epi8(v, colon), _mm256_cmpeq_epi8(v, comma)));
+        q |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, quote)) << i;
+        b |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, backslash)) << i;
+        w |= (uint64_t)(uint32_t)_mm256_movemask_epi8(ws) << i;
+        o |= (uint64_t)(uint32_t)_mm256_movemask_epi8(ops) << i;
+    }
+    m->quote = q;
+    m->backslash = b;
+    m->whitespace = w;
+    m->op = o;
+}
+#endif
+
+#if RJSON_SIMD_NEON
+/* Packs the 0x00/0xFF lanes of four compare results into one bit per byte */
+static uint64_t neon_movemask64(uint8x16_t v0, uint8x16_t v1, uint8x16_t v2, uint8x16_t v3)
+{
+    const uint8x16_t bits = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80,
+                             0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80};
+    uint8x16_t sum0 = vpaddq_u8(vandq_u8(v0, bits), vandq_u8(v1, bits));
+    uint8x16_t sum1 = vpaddq_u8(vandq_u8(v2, bits), vandq_u8(v3, bits));
+    sum0 = vpaddq_u8(sum0, sum1);
+    sum0 = vpaddq_u8(sum0, sum0);
+    return vgetq_lane_u64(vreinterpretq_u64_u8(sum0), 0);
+}
+
+static void classify_neon(const uint8_t *in, struct block_masks *m)
+{
+    uint8x16_t v[4], q[4], b[4], w[4], o[4];
+    const uint8x16_t fold = vdupq_n_u8(0x20);
+    for (int i = 0; i < 4; i++)
+    {
+        v[i] = vld1q_u8(in + 16 * i);
+        uint8x16_t folded = vorrq_u8(v[i], fold);
+        q[i] = vceqq_u8(v[i], vdupq_n_u8('"'));
+        b[i] = vceqq_u8(v[i], vdupq_n_u8('\\'));
+        w[i] = vorrq_u8(vorrq_u8(vceqq_u8(v[i], vdupq_n_u8(' ')), vceqq_u8(v[i], vdupq_n_u8('\t'))),
+                        vorrq_u8(vceqq_u8(v[i], vdupq_n_u8('\n')), vceqq_u8(v[i], vdupq_n_u8('\r'))));
+        o[i] = vorrq_u8(vorrq_u8(vceqq_u8(folded, vdupq_n_u8('{')), vceqq_u8(folded, vdupq_n_u8('}'))),
+                        vorrq_u8(vceqq_u8(v[i], vdupq_n_u8(':')), vceqq_u8(v[i], vdupq_n_u8(','))));
+    }
+    m->quote = neon_movemask64(q[0], q[1], q[2], q[3]);
+    m->backslash = neon_movemask64(b[0], b[1], b[2], b[3]);
+    m->whitespace = neon_movemask64(w[0], w[1], w[2], w[3]);
+    m->op = neon_movemask64(o[0], o[1], o[2], o[3]);
+}
+#endif
+
+typedef void (*classify_fn)(const uint8_t *in, struct block_masks *m);
+
+/* Picks the widest classification kernel the CPU supports */
+static classify_fn select_classifier(void)
+{
+#if RJSON_SIMD_AVX2
+    if (__builtin_cpu_supports("avx2"))
+        return classify_avx2;
+#endif
+#if RJSON_SIMD_SSE2
+    return classify_sse2;
+#elif RJSON_SIMD_NEON
+    return classify_neon;
+#else
+    return classify_scalar;
+#endif
+}
+
+// --- Bit Manipulation ---
+
+/* Bit i of the result is the XOR of bits 0..i of x */
+static uint64_t prefix_xor(uint64_t x)
+{
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+/*
+ * Returns the bytes escaped by a backslash, i.e. the byte following every
+ * backslash run of odd length. Runs are found with carry propagation: adding
+ * a run's start bit to the run ripples a carry to the byte just past its end,
+ * and the parity of start and end position gives the parity of its length.
+ * Runs starting on even and odd positions are handled separately.
+ */
+static uint64_t find_escaped(uint64_t backslash, struct index_state *st)
+{
+    const uint64_t even_bits = 0x5555555555555555ULL;
+    const uint64_t odd_bits = ~even_bits;
+
+    uint64_t start_edges = backslash & ~(backslash << 1);
+    // A run continuing from the previous block flips the parity of bit 0
+    uint64_t even_start_mask = even_bits ^ st->prev_odd_backslash;
+    uint64_t even_starts = start_edges & even_start_mask;
+    uint64_t odd_starts = start_edges & ~even_start_mask;
+
+    uint64_t even_carries = backslash + even_starts;
+    uint64_t odd_carries = backslash + odd_starts;
+    uint64_t ends_odd = odd_carries < backslash; // Carry out of bit 63
+    odd_carries |= st->prev_odd_backslash;
+    st->prev_odd_backslash = ends_odd;
+
+    uint64_t even_carry_ends = even_carries & ~backslash;
+    uint64_t odd_carry_ends = odd_carries & ~backslash;
+    return (even_carry_ends & odd_bits) | (odd_carry_ends & even_bits);
+}
+
+/* Appends the position of every set bit of `bits` */
+static uint32_t *flatten_bits(uint32_t *out, uint32_t base, uint64_t bits)
+{
+    while (bits)
+    {
+        *out++ = base + (uint32_t)rjson__ctz64(bits);
+        bits &= bits - 1;
+    }
+    return out;
+}
+
+/*
+ * Returns the bytes inside strings, from an opening quote up to (not
+ * including) its closing quote, and stores the unescaped quotes in `quote`.
+ */
+static uint64_t find_in_string(const struct block_masks *m, struct index_state *st, uint64_t *quote)
+{
+    uint64_t escaped = find_escaped(m->backslash, st);
+    *quote = m->quote & ~escaped;
+    uint64_t in_string = prefix_xor(*quote) ^ st->prev_in_string;
+    st->prev_in_string = (uint64_t)((int64_t)in_string >> 63);
+    return in_string;
+}
+
+/*
+ * Turns one classified block into structural positions: operators outside
+ * strings, opening quotes, and the first byte of every scalar run.
+ */
+static uint32_t *index_block(const struct block_masks *m, struct index_state *st, uint32_t base, uint32_t *out)
+{
+    uint64_t quote;
+    uint64_t in_string = find_in_string(m, st, &quote);
+    uint64_t op = m->op & ~in_string;
+    uint64_t scalar = ~(m->op | m->whitespace | quote | in_string);
+    uint64_t scalar_start = scalar & ~((scalar << 1) | st->prev_scalar);
+    st->prev_scalar = scalar >> 63;
+
+    return flatten_bits(out, base, op | (quote & in_string) | scalar_start);
+}
+
+// --- Public Internal API ---
+
+int rjson__index_build(const char *json, size_t length, struct rjson__index *index)
+{
+    index->positions = NULL;
+    index->count = 0;
+    if (length >= UINT32_MAX)
+        return -1; // Positions are 32-bit
+
+    // Every byte is at most one structural, plus the end sentinel
+    uint32_t *positions = (uint32_t *)malloc((length + 1) * sizeof(uint32_t));
+    if (!positions)
+        return -1;
+
+    classify_fn classify = select_classifier();
+    struct index_state st = {0};
+    struct block_masks m;
+    const uint8_t *in = (const uint8_t *)json;
+    uint32_t *out = positions;
+    size_t offset = 0;
+
+    for (; length - offset >= BLOCK_SIZE; offset += BLOCK_SIZE)
+    {
+        classify(in + offset, &m);
+        out = index_block(&m, &st, (uint32_t)offset, out);
+    }
+
+    // The tail is padded with whitespace, which never produces a structural
+    if (offset < length)
+    {
+        uint8_t tail[BLOCK_SIZE];
+        memset(tail, ' ', sizeof(tail));
+        memcpy(tail, in + offset, length - offset);
+        classify(tail, &m);
+        out = index_block(&m, &st, (uint32_t)offset, out);
+    }
+
+    *out = (uint32_t)length; // Sentinel: the end of the input
+    index->positions = positions;
+    index->count = (size_t)(out - positions);
+    return 0;
+}
+
+void rjson__index_free(struct rjson__index *index)
+{
+    free(index->positions);
+    index->positions = NULL;
+    index->count = 0;
+}
+
+// --- Subtree Skipping ---
+
+const char *rjson__skip_container(const char *json, const char *end)
+{
+    classify_fn classify = select_classifier();
+    struct index_state st = {0};
+    struct block_masks m;
+    const uint8_t *in = (const uint8_t *)json;
+    size_t length = (size_t)(end - json);
+    size_t depth = 0;
+
+    for (size_t offset = 0; offset < length; offset += BLOCK_SIZE)
+    {
+        // The tail is padded with whitespace, as for the index
+        const uint8_t *block = in + offset;
+        uint8_t tail[BLOCK_SIZE];
+        if (length - offset < BLOCK_SIZE)
+        {
+            memset(tail, ' ', sizeof(tail));
+            memcpy(tail, block, length - offset);
+            block = tail;
+        }
+        classify(block, &m);
+        uint64_t quote;
+        uint64_t op = m.op & ~find_in_string(&m, &st, &quote);
+
+        // Only brackets change the depth: '[' | 0x20 == '{' and ']' | 0x20 == '}',
+        // while ':' and ',' are unchanged by the OR.
+        while (op)
+        {
+            unsigned i = rjson__ctz64(op);
+            uint8_t c = block[i] | 0x20;
+            if (c == '{')
+                depth++;
+            else if (c == '}' && --depth == 0)
+                return json + offset + i + 1;
+            op &= op - 1;
+        }
+    }
+    return NULL; // Unbalanced
+}
+
+// --- String Scanning ---
+
+/*
+ * A byte is "special" inside a JSON string if it ends the plain run: the
+ * closing quote, a backslash, or an (invalid) unescaped control character.
+ */
+static int is_string_special(uint8_t c)
+{
+    return c == '"' || c == '\\' || c < 0x20;
+}
+
+/*
+ * SWAR fallback, eight bytes per step. The classic has-zero-byte trick may
+ * flag bytes above the first real match (borrows propagate upwards), but the
+ * lowest flagged byte is always exact, which is all a span needs.
+ */
+static size_t span_swar(const uint8_t *s, size_t n)
+{
+    size_t i = 0;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    const uint64_t ones = 0x0101010101010101ULL;
+    const uint64_t highs = 0x8080808080808080ULL;
+    for (; n - i >= 8; i += 8)
+    {
+        uint64_t w;
+        memcpy(&w, s + i, sizeof(w));
+        uint64_t quote = w ^ (ones * '"');
+        uint64_t backslash = w ^ (ones * '\\');
+        uint64_t special = (((quote - ones) & ~quote) |
+                            ((backslash - ones) & ~backslash) |
+                            ((w - ones * 0x20) & ~w)) & highs;
+        if (special)
+            return i + (rjson__ctz64(special) >> 3);
+    }
+#endif
+    for (; i < n; i++)
+    {
+        if (is_string_special(s[i]))
+            return i;
+    }
+    return n;
+}
+
+#if RJSON_SIMD_SSE2
+/* SSE2 has no unsigned byte compare; c <= 0x1F is tested as min(c, 0x1F) == c */
+static size_t span_sse2(const uint8_t *s, size_t n)
+{
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control = _mm_set1_epi8(0x1F);
+    size_t i = 0;
+    for (; n - i >= 16; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)(s + i));
+        __m128i special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+                                       _mm_cmpeq_epi8(_mm_min_epu8(v, control), v));
+        unsigned mask = (unsigned)_mm_movemask_epi8(special);
+        if (mask)
+            return i + rjson__ctz64(mask);
+    }
+    return i + span_swar(s + i, n - i);
+}
+#endif
+
+#if RJSON_SIMD_AVX2
+__attribute__((target("avx2"))) static uint64_t special_avx2(const uint8_t *s)
+{
+    __m256i v = _mm256_loadu_si256((const __m256i *)s);
+    __m256i special = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('"')),
+                                                      _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\'))),
+                                      _mm256_cmpeq_epi8(_mm256_min_epu8(v, _mm256_set1_epi8(0x1F)), v));
+    return (uint32_t)_mm256_movemask_epi8(special);
+}
+
+/* 64 bytes per iteration for long strings, then 32, then the SSE2 tail */
+__attribute__((target("avx2"))) static size_t span_avx2(const uint8_t *s, size_t n)
+{
+    size_t i = 0;
+    for (; n - i >= 64; i += 64)
+    {
+        uint64_t mask = special_avx2(s + i) | (special_avx2(s + i + 32) << 32);
+        if (mask)
+            return i + rjson__ctz64(mask);
+    }
+    if (n - i >= 32)
+    {
+        uint64_t mask = special_avx2(s + i);
+        if (mask)
+            return i + rjson__ctz64(mask);
+        i += 32;
+    }
+    return i + span_sse2(s + i, n - i);
+}
+#endif
+
+#if RJSON_SIMD_NEON
+static size_t span_neon(const uint8_t *s, size_t n)
+{
+    size_t i = 0;
+    for (; n - i >= 16; i += 16)
+    {
+        uint8x16_t v = vld1q_u8(s + i);
+        uint8x16_t special = vorrq_u8(vorrq_u8(vceqq_u8(v, vdupq_n_u8('"')), vceqq_u8(v, vdupq_n_u8('\\'))),
+                                      vcltq_u8(v, vdupq_n_u8(0x20)));
+        // Narrow each 0x00/0xFF lane to a nibble: one 64-bit mask, 4 bits per byte
+        uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(special), 4)), 0);
+        if (mask)
+            return i + (rjson__ctz64(mask) >> 2);
+    }
+    return i + span_swar(s + i, n - i);
+}
+#endif
+
+size_t rjson__string_span(const char *s, size_t n)
+{
+    const uint8_t *in = (const uint8_t *)s;
+#if RJSON_SIMD_AVX2
+    if (n >= 32 && __builtin_cpu_supports("avx2"))
+        return span_avx2(in, n);
+#endif
+#if RJSON_SIMD_SSE2
+    return span_sse2(in, n);
+#elif RJSON_SIMD_NEON
+    return span_neon(in, n);
+#else
+    return span_swar(in, n);
+#endif
+}
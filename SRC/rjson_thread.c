@@ -0,0 +1,66 @@
+#include "rjson_internal.h"
+#include <stdlib.h>
+
+/*
+ * Worker threads shared by the parallel parsers. Without pthreads
+ * (RJSON_THREADS unset) only worker 0 runs, on the calling thread, and
+ * drains all of the work itself.
+ */
+
+#if RJSON_THREADS
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+// Most workers started per online CPU, whatever the caller asks for
+#define THREADS_PER_CPU 4
+
+static size_t online_cpus(void)
+{
+#if RJSON_THREADS && defined(_SC_NPROCESSORS_ONLN)
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (size_t)n : 1;
+#else
+    return 1;
+#endif
+}
+
+size_t rjson__thread_count(unsigned int requested, size_t max_work)
+{
+    size_t cpus = online_cpus();
+    size_t count = requested > 0 ? requested : cpus;
+    if (count > cpus * THREADS_PER_CPU)
+        count = cpus * THREADS_PER_CPU;
+    if (count > max_work)
+        count = max_work;
+    return count > 0 ? count : 1;
+}
+
+void rjson__run_workers(void *(*run)(void *), void *workers, size_t worker_size, size_t count)
+{
+    char *base = (char *)workers;
+#if RJSON_THREADS
+    pthread_t *threads = count > 1 ? (pthread_t *)malloc((count - 1) * sizeof(pthread_t)) : NULL;
+    unsigned char *started = count > 1 ? (unsigned char *)calloc(count - 1, 1) : NULL;
+    if (threads && started)
+    {
+        for (size_t i = 1; i < count; i++)
+            started[i - 1] = pthread_create(&threads[i - 1], NULL, run, base + i * worker_size) == 0;
+    }
+    run(base);
+    if (threads && started)
+    {
+        for (size_t i = 1; i < count; i++)
+        {
+            if (started[i - 1])
+                pthread_join(threads[i - 1], NULL);
+        }
+    }
+    free(threads);
+    free(started);
+#else
+    (void)worker_size;
+    (void)count;
+    run(base);
+#endif
+}
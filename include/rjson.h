@@ -2,6 +2,7 @@
 #define RJSON_H
 
 #include <stddef.h>
+#include <stdint.h>
 
 // --- Type Definitions ---
 
@@ -15,7 +16,15 @@ typedef enum {
     RJSON_OBJECT
 } rjson_type;
 
+// Representation of an RJSON_NUMBER (see rjson_number_get_kind())
+typedef enum {
+    RJSON_NUMBER_DOUBLE,
+    RJSON_NUMBER_INT64,
+    RJSON_NUMBER_UINT64
+} rjson_number_kind;
+
 struct rjson_value; // Forward declaration
+struct rjson_object_index; // Opaque, see rjson_object
 
 typedef struct {
     struct rjson_value** elements;
@@ -26,19 +35,122 @@ typedef struct {
     char** keys;
     struct rjson_value** values;
     size_t count;
+    // Hash index of the keys of wide objects, maintained by the library
+    // (NULL for small objects). Lookups stay correct when `keys`, `values`
+    // or `count` are changed by hand.
+    struct rjson_object_index* index;
 } rjson_object;
 
 typedef struct rjson_value {
     rjson_type type;
+    unsigned int flags; // Storage bits managed by the library; do not modify.
     union {
         int bool_val;
-        double num_val;
-        char* str_val;
+        struct {
+            double num_val; // Always set; the nearest double for 64-bit integers
+            union {
+                int64_t int_val;   // Exact value when the kind is RJSON_NUMBER_INT64
+                uint64_t uint_val; // Exact value when the kind is RJSON_NUMBER_UINT64
+            };
+        };
+        struct {
+            const char* num_text; // Unconverted number (RJSON_PARSE_LAZY_NUMBERS); use the accessors
+            size_t num_len;
+        };
+        struct {
+            // NUL-terminated unless parsed with RJSON_PARSE_ZEROCOPY. NULL
+            // only for strings stored in str_inline (RJSON_PARSE_INLINE_STRINGS).
+            char* str_val;
+            size_t str_len; // Length in bytes, excluding the terminator
+            char str_inline[2 * sizeof(void*)]; // See RJSON_PARSE_INLINE_STRINGS
+        };
         rjson_array arr_val;
         rjson_object obj_val;
     } as;
 } rjson_value;
 
+/**
+ * @brief A bump allocator that owns every node and string of the documents
+ * parsed into it. Opaque; see rjson_arena_new().
+ */
+typedef struct rjson_arena rjson_arena;
+
+// --- Parse Options ---
+
+/**
+ * Number of readable bytes a caller must guarantee past the end of the input
+ * when passing RJSON_PARSE_PADDED. Their contents do not matter.
+ */
+#define RJSON_PADDING 64
+
+/**
+ * The input is followed by at least RJSON_PADDING readable bytes, which lets
+ * the scanner use wide loads up to the very end of the input.
+ */
+#define RJSON_PARSE_PADDED 0x1u
+
+/**
+ * Escape-free string values become zero-copy views: `str_val` points into the
+ * input and is NOT NUL-terminated (use `str_len` or rjson_string_get()). Strings
+ * containing escapes are still decoded into their own NUL-terminated copy.
+ * Only values are affected: object keys are always copied into NUL-terminated
+ * strings, so `obj_val.keys` stays usable as plain C strings.
+ * The input must outlive the tree; for arena documents,
+ * rjson_arena_add_cleanup() can tie the input's release to the arena.
+ */
+#define RJSON_PARSE_ZEROCOPY 0x2u
+
+/**
+ * Disables the structural index. Inputs of at least RJSON_INDEX_MIN_LENGTH
+ * bytes are normally pre-scanned with SIMD to locate every token before the
+ * tree is built; this flag forces the single-pass byte scanner instead.
+ */
+#define RJSON_PARSE_NO_INDEX 0x4u
+
+/**
+ * Numbers are validated but not converted: the node records the number's
+ * source text and converts it on first access through
+ * rjson_number_get_double(), rjson_number_get_kind() or the integer getters,
+ * caching the result. `num_val`/`int_val` must not be read directly before
+ * that. Unconverted numbers serialize as their original text. The input must
+ * outlive the tree (as for RJSON_PARSE_ZEROCOPY). Numbers with an exponent
+ * or of unusual length are still converted during the parse so that
+ * overflow is reported as a parse error.
+ */
+#define RJSON_PARSE_LAZY_NUMBERS 0x8u
+
+/**
+ * Object keys are interned per document: each distinct key is stored once
+ * and every object using it points to that copy, so documents that repeat
+ * the same keys across many objects allocate (and hold) each key only once.
+ * Keys then compare equal by address within the document. Ignored by
+ * rjson_parse_insitu(), whose keys live in the buffer.
+ */
+#define RJSON_PARSE_INTERN_KEYS 0x10u
+
+/**
+ * Accept \u0000 escapes in string values instead of rejecting them. The
+ * decoded strings may then contain NUL bytes, so read them by length with
+ * rjson_string_get(). Object keys are NUL-terminated strings: a key that
+ * decodes to a NUL byte is still rejected.
+ */
+#define RJSON_PARSE_ALLOW_NUL 0x20u
+
+/**
+ * Short strings (up to 2 * sizeof(void*) - 1 bytes) are stored inside their
+ * node instead of in a separate allocation. Their `str_val` is NULL, so
+ * read every string of such a document with rjson_string_get(). Ignored by
+ * rjson_parse_insitu() and for zero-copy views.
+ */
+#define RJSON_PARSE_INLINE_STRINGS 0x40u
+
+typedef struct {
+    unsigned int flags; // Bitwise OR of RJSON_PARSE_* values (0 for defaults).
+    rjson_arena* arena; // Allocate the document from this arena (optional, may be NULL).
+    size_t max_depth;   // Maximum nesting of arrays/objects (0 for the default of 512).
+                        // Nesting does not use the C stack, so large limits are safe.
+} rjson_parse_options;
+
 // --- Public API ---
 
 /**
@@ -49,8 +161,504 @@ typedef struct rjson_value {
  */
 rjson_value* rjson_parse(const char* json_string);
 
+/**
+ * @brief Parses a length-delimited JSON buffer into a tree of rjson_value nodes.
+ * The buffer does not need to be NUL-terminated; no byte at or past
+ * `json + length` is read. An embedded NUL byte is a parse error.
+ *
+ * @param json The JSON text.
+ * @param length The number of bytes in `json`.
+ * @return A pointer to the root rjson_value, or NULL on failure.
+ */
+rjson_value* rjson_parse_n(const char* json, size_t length);
+
+/**
+ * @brief Parses a length-delimited JSON buffer with explicit options.
+ *
+ * @param json The JSON text (need not be NUL-terminated).
+ * @param length The number of bytes in `json`.
+ * @param options Parse options, or NULL for the defaults of rjson_parse_n().
+ * @return A pointer to the root rjson_value, or NULL on failure. When
+ * `options->arena` is set the tree is owned by the arena (see rjson_parse_arena()).
+ */
+rjson_value* rjson_parse_ex(const char* json, size_t length, const rjson_parse_options* options);
+
+/**
+ * @brief Parses a mutable buffer in place.
+ * Strings and object keys are unescaped and NUL-terminated inside `buffer`,
+ * and `str_val`/keys point into it instead of being allocated. The buffer's
+ * contents are overwritten and it must outlive the returned tree. Nodes are
+ * still allocated from the heap (free with rjson_free()) or from
+ * `options->arena`.
+ *
+ * @param buffer The writable JSON text (need not be NUL-terminated).
+ * @param length The number of bytes in `buffer`.
+ * @param options Parse options, or NULL for the defaults.
+ * @return A pointer to the root rjson_value, or NULL on failure.
+ */
+rjson_value* rjson_parse_insitu(char* buffer, size_t length, const rjson_parse_options* options);
+
+/**
+ * @brief Parses a NUL-terminated JSON string into an arena.
+ * Nodes, strings and child arrays are bump-allocated from `arena` instead of
+ * the heap. The returned tree is owned by the arena: it stays valid until
+ * rjson_arena_reset() or rjson_arena_free(), and rjson_free() on any of its
+ * nodes is a no-op. Containers in the tree are read-only
+ * (rjson_array_add()/rjson_object_add() return -1 on them).
+ *
+ * @param arena The arena to allocate from.
+ * @param json_string The JSON string to parse.
+ * @return A pointer to the root rjson_value, or NULL on failure.
+ */
+rjson_value* rjson_parse_arena(rjson_arena* arena, const char* json_string);
+
+/**
+ * @brief Parses one large document on several threads.
+ * A pre-scan splits the root array or object at its own commas into runs of
+ * elements (or members), which are parsed concurrently and joined in order.
+ * The tree, and whether the input is rejected, are the same as with
+ * rjson_parse_ex(). Documents below a few hundred KiB, and roots that are
+ * not containers, are parsed on the calling thread.
+ *
+ * @param json The JSON text (need not be NUL-terminated).
+ * @param length The number of bytes in `json`.
+ * @param threads Worker threads (0: one per online CPU). At most four per
+ * online CPU are started, and fewer when the input has fewer chunks.
+ * @param options Parse options, or NULL for the defaults. With an arena,
+ * the other threads allocate from arenas of their own that are released
+ * together with `options->arena`.
+ * @return A pointer to the root rjson_value, or NULL on failure.
+ */
+rjson_value* rjson_parse_parallel(const char* json, size_t length, unsigned int threads,
+                                  const rjson_parse_options* options);
+
+/**
+ * @brief Parses a JSON file.
+ * Where available the file is memory-mapped read-only and parsed directly
+ * from the mapping, with sequential read-ahead advice; otherwise it is read
+ * into a single buffer. The file needs no terminator. With
+ * RJSON_PARSE_ZEROCOPY or RJSON_PARSE_LAZY_NUMBERS and an arena, the tree
+ * keeps referencing the mapping, which is released together with the arena;
+ * heap documents ignore both flags and copy their strings.
+ *
+ * @param path The file to parse.
+ * @param options Parse options, or NULL for the defaults.
+ * @return A pointer to the root rjson_value, or NULL if the file cannot be
+ * read or is not valid JSON.
+ */
+rjson_value* rjson_parse_file(const char* path, const rjson_parse_options* options);
+
+// --- SAX Parser ---
+
+/**
+ * Return values of rjson_sax_handler callbacks.
+ */
+typedef enum {
+    RJSON_SAX_CONTINUE = 0, // Keep parsing
+    RJSON_SAX_ABORT,        // Stop; rjson_sax_parse() returns -1
+    RJSON_SAX_SKIP          // From start_object/start_array: skip the container's contents
+                            // and its end event. From key: skip the member's value.
+                            // Anywhere else: same as RJSON_SAX_CONTINUE.
+} rjson_sax_result;
+
+/**
+ * Event callbacks of rjson_sax_parse(). Any callback may be NULL. Each one
+ * receives the `ctx` passed to rjson_sax_parse() and returns an
+ * rjson_sax_result. Skipped values are still validated.
+ */
+typedef struct {
+    int (*start_object)(void* ctx);
+    int (*end_object)(void* ctx);
+    int (*start_array)(void* ctx);
+    int (*end_array)(void* ctx);
+    // Strings and keys: decoded bytes, NOT NUL-terminated. They point into the
+    // input when the string has no escapes, and are only valid during the call.
+    int (*key)(void* ctx, const char* str, size_t len);
+    int (*string)(void* ctx, const char* str, size_t len);
+    // A temporary RJSON_NUMBER node, valid during the call: read it with
+    // rjson_number_get_double(), rjson_number_get_kind() and the integer getters.
+    int (*number)(void* ctx, const rjson_value* number);
+    int (*boolean)(void* ctx, int value);
+    int (*null)(void* ctx);
+} rjson_sax_handler;
+
+/**
+ * @brief Parses a length-delimited JSON buffer into a stream of events.
+ * Builds no tree and allocates nothing per value: memory use is bounded by
+ * the nesting depth.
+ *
+ * @param json The JSON text (need not be NUL-terminated).
+ * @param length The number of bytes in `json`.
+ * @param handler The event callbacks.
+ * @param ctx Passed to every callback.
+ * @param options Parse options (flags, depth limit; the arena is unused), or NULL.
+ * @return 0 if the whole document is valid, -1 on a parse error or if a
+ * callback aborted. Events already delivered are not retracted on error.
+ */
+int rjson_sax_parse(const char* json, size_t length, const rjson_sax_handler* handler, void* ctx,
+                    const rjson_parse_options* options);
+
+// --- On-demand Cursor ---
+
+/**
+ * A position on a value inside unparsed JSON text. Navigating with a cursor
+ * reads the input only as far as needed and builds no nodes: values that are
+ * not asked for are skipped by bracket matching and are NOT validated. The
+ * text must outlive every cursor into it. Cursors are plain values that may
+ * be copied freely; the fields are private.
+ */
+typedef struct {
+    const char* pos;
+    const char* end;
+    unsigned int flags;
+} rjson_cursor;
+
+/**
+ * @brief Points a cursor at the root value of a document.
+ *
+ * @param cursor Receives the cursor.
+ * @param json The JSON text (need not be NUL-terminated).
+ * @param length The number of bytes in `json`.
+ * @return 0 on success, -1 if the text holds no value.
+ */
+int rjson_cursor_init(rjson_cursor* cursor, const char* json, size_t length);
+
+/**
+ * @brief Reports the type of the value at the cursor from its first byte.
+ *
+ * @param cursor The cursor.
+ * @param out Receives the type.
+ * @return 0 on success, -1 if no value starts at the cursor.
+ */
+int rjson_cursor_get_type(const rjson_cursor* cursor, rjson_type* out);
+
+/**
+ * @brief Finds a member of the object at the cursor.
+ * Scans the members in order, skipping the values of the others.
+ *
+ * @param object A cursor on an object.
+ * @param key The NUL-terminated key (compared after decoding escapes).
+ * @param out Receives a cursor on the member's value.
+ * @return 0 if found, -1 if not found, not an object, or malformed.
+ */
+int rjson_cursor_find_field(const rjson_cursor* object, const char* key, rjson_cursor* out);
+
+/**
+ * @brief Moves to the first element of the array at the cursor.
+ *
+ * @param array A cursor on an array.
+ * @param out Receives a cursor on the first element.
+ * @return 0 on success, -1 if the array is empty, not an array, or malformed.
+ */
+int rjson_cursor_first_element(const rjson_cursor* array, rjson_cursor* out);
+
+/**
+ * @brief Advances an element cursor to the next element of its array.
+ *
+ * @param element A cursor from rjson_cursor_first_element() or this function.
+ * @return 0 on success, -1 after the last element or if malformed.
+ */
+int rjson_cursor_next_element(rjson_cursor* element);
+
+/**
+ * @brief Reads the number at the cursor as a double.
+ *
+ * @return 0 on success, -1 if the value is not a valid number.
+ */
+int rjson_cursor_get_double(const rjson_cursor* cursor, double* out);
+
+/**
+ * @brief Reads the number at the cursor as an exact int64_t.
+ *
+ * @return 0 on success, -1 if the value is not an integer that fits int64_t.
+ */
+int rjson_cursor_get_int64(const rjson_cursor* cursor, int64_t* out);
+
+/**
+ * @brief Reads the boolean at the cursor.
+ *
+ * @return 0 on success (`*out` is 0 or 1), -1 if the value is not a boolean.
+ */
+int rjson_cursor_get_bool(const rjson_cursor* cursor, int* out);
+
+/**
+ * @brief Returns the string at the cursor as a view of the input.
+ * Only strings without escapes can be viewed without decoding; use
+ * rjson_cursor_get_value() for others.
+ *
+ * @param cursor The cursor.
+ * @param str Receives the string bytes (NOT NUL-terminated).
+ * @param len Receives the length in bytes (optional, can be NULL).
+ * @return 0 on success, -1 if the value is not a string or contains escapes.
+ */
+int rjson_cursor_get_string_view(const rjson_cursor* cursor, const char** str, size_t* len);
+
+/**
+ * @brief Fully parses the value at the cursor into a tree.
+ *
+ * @param cursor The cursor.
+ * @param options Parse options, or NULL for the defaults.
+ * @return The value (free with rjson_free(), or owned by `options->arena`),
+ * or NULL if it is invalid.
+ */
+rjson_value* rjson_cursor_get_value(const rjson_cursor* cursor, const rjson_parse_options* options);
+
+// --- Tape Documents ---
+
+/**
+ * A parsed document stored flat instead of as a tree of nodes: one
+ * contiguous array of 64-bit words in document order (one per value or key,
+ * plus a second word holding the bits of a number) and one buffer for all
+ * strings. An array or object is an opening and a closing word, and the
+ * opening word records where the container ends, so whole subtrees are
+ * skipped in O(1). Values are addressed by their index on the tape; the
+ * root is at index 0, which is never an element or member, so 0 also means
+ * "not found". Opaque and read-only; see rjson_tape_parse().
+ */
+typedef struct rjson_tape rjson_tape;
+
+/**
+ * @brief Parses a length-delimited JSON buffer into a tape.
+ * Accepts exactly the documents rjson_parse_ex() accepts. The tape copies
+ * every string, so the input may be released right after the call.
+ *
+ * @param json The JSON text (need not be NUL-terminated).
+ * @param length The number of bytes in `json`.
+ * @param options Parse options (flags, depth limit; the arena is unused), or NULL.
+ * @return The tape (free with rjson_tape_free()), or NULL on failure.
+ */
+rjson_tape* rjson_tape_parse(const char* json, size_t length, const rjson_parse_options* options);
+
+/**
+ * @brief Frees a tape.
+ *
+ * @param tape The tape (may be NULL).
+ */
+void rjson_tape_free(rjson_tape* tape);
+
+/**
+ * @brief Returns the type of the value at `index` (keys are RJSON_STRING).
+ * @return The type, or RJSON_NULL if `index` is not a value.
+ */
+rjson_type rjson_tape_get_type(const rjson_tape* tape, size_t index);
+
+/**
+ * @brief Returns the number of elements of an array or members of an object, in O(1).
+ * @return The count, or 0 if `index` is not a container.
+ */
+size_t rjson_tape_count(const rjson_tape* tape, size_t index);
+
+/**
+ * @brief Returns the first element of an array, or the first key of an object.
+ * A member's value always directly follows its key (at key index + 1).
+ *
+ * @return Its index, or 0 if the container is empty or `index` is not a container.
+ */
+size_t rjson_tape_first(const rjson_tape* tape, size_t index);
+
+/**
+ * @brief Returns the next element (or, from a key, the next key) of the same
+ * container, skipping nested containers in O(1).
+ *
+ * @return Its index, or 0 after the last one.
+ */
+size_t rjson_tape_next(const rjson_tape* tape, size_t index);
+
+/**
+ * @brief Returns an element of an array by position.
+ * @return Its index, or 0 if out of range or `array` is not an array.
+ */
+size_t rjson_tape_array_get(const rjson_tape* tape, size_t array, size_t position);
+
+/**
+ * @brief Retrieves a value from an object by its key.
+ *
+ * @param tape The tape.
+ * @param object The index of an object.
+ * @param key The NUL-terminated string key to search for.
+ * @return The index of the value, or 0 if not found.
+ */
+size_t rjson_tape_object_get_value(const rjson_tape* tape, size_t object, const char* key);
+
+/**
+ * @brief Returns the contents of a string or key.
+ *
+ * @param tape The tape.
+ * @param index The index of a string or key.
+ * @param out_len Receives the length in bytes (optional, can be NULL).
+ * @return The NUL-terminated string, owned by the tape, or NULL if `index`
+ * is not a string.
+ */
+const char* rjson_tape_string_get(const rjson_tape* tape, size_t index, size_t* out_len);
+
+/**
+ * @brief Returns the value of a boolean: 1 for true, 0 for false or a non-boolean.
+ */
+int rjson_tape_bool_get(const rjson_tape* tape, size_t index);
+
+/**
+ * @brief Returns a number as a double (0.0 for non-numbers), see rjson_number_get_double().
+ */
+double rjson_tape_number_get_double(const rjson_tape* tape, size_t index);
+
+/**
+ * @brief Returns how a number is stored, see rjson_number_get_kind().
+ */
+rjson_number_kind rjson_tape_number_get_kind(const rjson_tape* tape, size_t index);
+
+/**
+ * @brief Reads a number as an exact int64_t, see rjson_number_get_int64().
+ * @return 0 on success, -1 if not a number representable as int64_t.
+ */
+int rjson_tape_number_get_int64(const rjson_tape* tape, size_t index, int64_t* out);
+
+/**
+ * @brief Reads a number as an exact uint64_t, see rjson_number_get_uint64().
+ * @return 0 on success, -1 if not a number representable as uint64_t.
+ */
+int rjson_tape_number_get_uint64(const rjson_tape* tape, size_t index, uint64_t* out);
+
+/**
+ * @brief Serializes a tape into a compact JSON string.
+ * Produces the same output as rjson_serialize() on the tree of the same
+ * document, in one linear pass over the tape.
+ *
+ * @param tape The tape.
+ * @param out_string Receives the NUL-terminated JSON string; free with `free()`.
+ * @param out_len Receives the length (optional, can be NULL).
+ * @return 0 on success, -1 on failure (e.g., OOM).
+ */
+int rjson_tape_serialize(const rjson_tape* tape, char** out_string, size_t* out_len);
+
+// --- NDJSON ---
+
+/**
+ * Options for parsing newline-delimited JSON (NDJSON / JSON Lines).
+ */
+typedef struct {
+    unsigned int threads;      // Worker threads (0: one per online CPU); capped at four
+                               // per online CPU, and fewer for small inputs.
+    rjson_parse_options parse; // Options for every record. `parse.arena` is ignored:
+                               // each worker allocates from its own arena.
+} rjson_ndjson_options;
+
+/**
+ * The documents of an NDJSON buffer, in input order. Opaque; see
+ * rjson_ndjson_parse().
+ */
+typedef struct rjson_ndjson_batch rjson_ndjson_batch;
+
+/**
+ * @brief Parses every record of an NDJSON buffer on several threads.
+ * Each non-blank line is one record; blank lines are skipped. Records are
+ * parsed in parallel into per-thread arenas.
+ *
+ * @param data The NDJSON text (need not be NUL-terminated).
+ * @param length The number of bytes in `data`.
+ * @param options Options, or NULL for the defaults.
+ * @return The batch (free with rjson_ndjson_free()), or NULL on OOM. Invalid
+ * records do not fail the batch; see rjson_ndjson_error_count().
+ */
+rjson_ndjson_batch* rjson_ndjson_parse(const char* data, size_t length, const rjson_ndjson_options* options);
+
+/**
+ * @brief Returns the number of records in a batch.
+ */
+size_t rjson_ndjson_count(const rjson_ndjson_batch* batch);
+
+/**
+ * @brief Returns the number of records that failed to parse.
+ */
+size_t rjson_ndjson_error_count(const rjson_ndjson_batch* batch);
+
+/**
+ * @brief Returns a record of a batch.
+ * The document is owned by the batch (read-only containers, as for arena
+ * documents) and stays valid until rjson_ndjson_free().
+ *
+ * @param batch The batch.
+ * @param index The record number, from 0 in input order.
+ * @return The document, or NULL if the record is invalid or out of range.
+ */
+rjson_value* rjson_ndjson_get(const rjson_ndjson_batch* batch, size_t index);
+
+/**
+ * @brief Frees a batch and all of its documents.
+ */
+void rjson_ndjson_free(rjson_ndjson_batch* batch);
+
+/**
+ * @brief Parses every record of an NDJSON buffer on several threads and
+ * streams each one to a callback instead of keeping it.
+ * The callback runs on the worker threads, concurrently and in no
+ * particular order; `index` is the record number in input order. `document`
+ * is NULL for an invalid record, and is only valid until the callback
+ * returns. Memory use does not grow with the number of records.
+ *
+ * @param data The NDJSON text (need not be NUL-terminated).
+ * @param length The number of bytes in `data`.
+ * @param options Options, or NULL for the defaults.
+ * @param callback Called once per record. Return 0 to continue; any other
+ * value stops all workers.
+ * @param ctx Passed to the callback.
+ * @return 0 if every record was delivered, -1 if the callback stopped the
+ * parse or on OOM.
+ */
+int rjson_ndjson_each(const char* data, size_t length, const rjson_ndjson_options* options,
+                      int (*callback)(void* ctx, size_t index, rjson_value* document), void* ctx);
+
+// --- Push Parser ---
+
+/**
+ * An incremental parser that accepts a document in arbitrary chunks, e.g. as
+ * it arrives from the network. Its state (including a string, escape or
+ * number split between chunks) is kept across calls; only a token that
+ * straddles a chunk boundary is copied, never the whole document.
+ */
+typedef struct rjson_push_parser rjson_push_parser;
+
+/**
+ * @brief Creates a push parser.
+ * RJSON_PARSE_ZEROCOPY, RJSON_PARSE_LAZY_NUMBERS and RJSON_PARSE_PADDED are
+ * ignored: chunks need not outlive the call that feeds them.
+ *
+ * @param options Parse options (arena, depth limit), or NULL for the defaults.
+ * @return The parser, or NULL on OOM. Release it with rjson_push_parser_free().
+ */
+rjson_push_parser* rjson_push_parser_new(const rjson_parse_options* options);
+
+/**
+ * @brief Feeds the next chunk of the document.
+ *
+ * @param parser The push parser.
+ * @param chunk The next bytes of the document (need not be NUL-terminated).
+ * @param len The number of bytes in `chunk` (may be 0).
+ * @return 0 on success, -1 if the input so far is not valid JSON or on OOM.
+ * Errors are sticky: later calls fail and rjson_push_finish() returns NULL.
+ */
+int rjson_push_feed(rjson_push_parser* parser, const char* chunk, size_t len);
+
+/**
+ * @brief Signals the end of the input and returns the document.
+ * The parser cannot be fed again afterwards.
+ *
+ * @param parser The push parser.
+ * @return The root rjson_value, owned by the caller (or by the arena), or
+ * NULL if the document is invalid or incomplete.
+ */
+rjson_value* rjson_push_finish(rjson_push_parser* parser);
+
+/**
+ * @brief Frees a push parser and any partially parsed document it holds.
+ *
+ * @param parser The push parser (may be NULL).
+ */
+void rjson_push_parser_free(rjson_push_parser* parser);
+
 /**
  * @brief Serializes a tree of rjson_value nodes into a compact JSON string.
+ * Like parsing, it does not recurse on the C stack, so any tree the parser
+ * accepts (whatever its max_depth) can be serialized.
  *
  * @param value The root rjson_value to serialize.
  * @param out_string A pointer to a char* which will be allocated and filled
@@ -70,6 +678,9 @@ void rjson_free(rjson_value* value);
 
 /**
  * @brief Retrieves a value from an RJSON_OBJECT by its key.
+ * Wide objects keep a hash index of their keys (maintained by
+ * rjson_object_add()), so lookups in them take constant time on average.
+ * With duplicate keys the first member is returned.
  *
  * @param object A pointer to an rjson_value of type RJSON_OBJECT.
  * @param key The NUL-terminated string key to search for.
@@ -77,6 +688,79 @@ void rjson_free(rjson_value* value);
  */
 rjson_value* rjson_object_get_value(const rjson_value* object, const char* key);
 
+/**
+ * @brief Retrieves a value from an RJSON_OBJECT by a key of `key_len` bytes.
+ *
+ * @param object A pointer to an rjson_value of type RJSON_OBJECT.
+ * @param key The key bytes (need not be NUL-terminated). A key containing
+ * NUL matches nothing.
+ * @param key_len The length of the key in bytes.
+ * @return A pointer to the corresponding rjson_value, or NULL if not found.
+ */
+rjson_value* rjson_object_get_value_n(const rjson_value* object, const char* key, size_t key_len);
+
+/**
+ * @brief Returns the key of the member at `index` of an RJSON_OBJECT.
+ *
+ * @param object A pointer to an rjson_value of type RJSON_OBJECT.
+ * @param index The member index, below `as.obj_val.count`.
+ * @param out_len Receives the key length in bytes (optional, can be NULL).
+ * @return The NUL-terminated key, or NULL if `object` is not an object or
+ * `index` is out of range.
+ */
+const char* rjson_object_get_key(const rjson_value* object, size_t index, size_t* out_len);
+
+/**
+ * @brief Returns the contents of an RJSON_STRING.
+ *
+ * @param value A pointer to an rjson_value of type RJSON_STRING.
+ * @param out_len Receives the length in bytes (optional, can be NULL).
+ * @return The string bytes, or NULL if `value` is not a string. Not
+ * NUL-terminated for zero-copy views (see RJSON_PARSE_ZEROCOPY).
+ */
+const char* rjson_string_get(const rjson_value* value, size_t* out_len);
+
+/**
+ * @brief Returns the value of an RJSON_NUMBER as a double.
+ * Converts (and caches) lazily parsed numbers, see RJSON_PARSE_LAZY_NUMBERS.
+ * Not safe to call concurrently on the same unconverted node.
+ *
+ * @param value A pointer to an rjson_value of type RJSON_NUMBER.
+ * @return The number, or 0.0 if `value` is not a number.
+ */
+double rjson_number_get_double(const rjson_value* value);
+
+/**
+ * @brief Returns how an RJSON_NUMBER is stored.
+ * Parsed integers without fraction or exponent that fit in 64 bits keep
+ * their exact value (RJSON_NUMBER_INT64, or RJSON_NUMBER_UINT64 above
+ * INT64_MAX); every other number is a double. `num_val` is valid for all kinds.
+ *
+ * @param value A pointer to an rjson_value of type RJSON_NUMBER.
+ * @return The number's kind (RJSON_NUMBER_DOUBLE for non-numbers).
+ */
+rjson_number_kind rjson_number_get_kind(const rjson_value* value);
+
+/**
+ * @brief Reads an RJSON_NUMBER as an exact int64_t.
+ *
+ * @param value A pointer to an rjson_value of type RJSON_NUMBER.
+ * @param out Receives the value.
+ * @return 0 on success, -1 if `value` is not a number or its value is not
+ * an integer representable as int64_t.
+ */
+int rjson_number_get_int64(const rjson_value* value, int64_t* out);
+
+/**
+ * @brief Reads an RJSON_NUMBER as an exact uint64_t.
+ *
+ * @param value A pointer to an rjson_value of type RJSON_NUMBER.
+ * @param out Receives the value.
+ * @return 0 on success, -1 if `value` is not a number or its value is not
+ * an integer representable as uint64_t.
+ */
+int rjson_number_get_uint64(const rjson_value* value, uint64_t* out);
+
 /**
  * @brief Prints a formatted representation of an rjson_value to stdout.
  *
@@ -86,6 +770,42 @@ rjson_value* rjson_object_get_value(const rjson_value* object, const char* key);
 void rjson_print(const rjson_value* value, int indent);
 
 
+// --- Arena Management ---
+
+/**
+ * @brief Creates an empty arena.
+ * @param chunk_size Size of each memory chunk in bytes (0 for the default of 64 KiB).
+ * Requests larger than a chunk get a dedicated chunk.
+ * @return A pointer to the new arena, or NULL on failure.
+ */
+rjson_arena* rjson_arena_new(size_t chunk_size);
+
+/**
+ * @brief Releases every document parsed into the arena, keeping its chunks
+ * for reuse by the next parse. All pointers into the arena become invalid.
+ * @param arena The arena to reset.
+ */
+void rjson_arena_reset(rjson_arena* arena);
+
+/**
+ * @brief Registers a callback that runs when the arena is next reset or freed,
+ * before its memory is released. Callbacks run in reverse registration order.
+ * Typically used to release a zero-copy document's input buffer.
+ *
+ * @param arena The arena.
+ * @param release The callback.
+ * @param ctx The argument passed to `release`.
+ * @return 0 on success, -1 on failure (OOM).
+ */
+int rjson_arena_add_cleanup(rjson_arena* arena, void (*release)(void* ctx), void* ctx);
+
+/**
+ * @brief Frees the arena, its chunks and every document parsed into it.
+ * @param arena The arena to free.
+ */
+void rjson_arena_free(rjson_arena* arena);
+
+
 // --- JSON Construction Helpers ---
 
 /**
@@ -107,6 +827,14 @@ rjson_value* rjson_array_new(void);
  */
 rjson_value* rjson_string_new(const char* s);
 
+/**
+ * @brief Creates a new RJSON_STRING from `len` bytes, which may include NUL.
+ * @param s The bytes to copy (may be NULL when `len` is 0).
+ * @param len The number of bytes.
+ * @return A pointer to the new rjson_value, or NULL on failure.
+ */
+rjson_value* rjson_string_new_n(const char* s, size_t len);
+
 /**
  * @brief Creates a new RJSON_NUMBER.
  * @param n The number.
@@ -114,6 +842,20 @@ rjson_value* rjson_string_new(const char* s);
  */
 rjson_value* rjson_number_new(double n);
 
+/**
+ * @brief Creates a new RJSON_NUMBER holding an exact signed 64-bit integer.
+ * @param n The number.
+ * @return A pointer to the new rjson_value, or NULL on failure.
+ */
+rjson_value* rjson_int64_new(int64_t n);
+
+/**
+ * @brief Creates a new RJSON_NUMBER holding an exact unsigned 64-bit integer.
+ * @param n The number.
+ * @return A pointer to the new rjson_value, or NULL on failure.
+ */
+rjson_value* rjson_uint64_new(uint64_t n);
+
 /**
  * @brief Creates a new RJSON_BOOL.
  * @param b The boolean value (0 for false, non-zero for true).
@@ -139,6 +881,18 @@ rjson_value* rjson_null_new(void);
  */
 int rjson_object_add(rjson_value* object, const char* key, rjson_value* value);
 
+/**
+ * @brief Adds a key-value pair to an RJSON_OBJECT, with a key of `key_len`
+ * bytes (need not be NUL-terminated). Otherwise as rjson_object_add().
+ *
+ * @param object The RJSON_OBJECT to modify.
+ * @param key The key bytes.
+ * @param key_len The length of the key in bytes.
+ * @param value The rjson_value to add.
+ * @return 0 on success, -1 on failure (out of memory, or a key containing NUL).
+ */
+int rjson_object_add_n(rjson_value* object, const char* key, size_t key_len, rjson_value* value);
+
 /**
  * @brief Adds an element to an RJSON_ARRAY.
  * The value is "donated" and will be freed when the parent array is freed.
@@ -0,0 +1,121 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h> // For strcmp
+#include "rjson.h"
+
+// ANSI Color codes
+#define GREEN "\033[0;32m"
+#define RED "\033[0;31m"
+#define RESET "\033[0m"
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+void assert_true(int condition, const char *test_name)
+{
+    if (condition)
+    {
+        printf("%s[PASS]%s %s\n", GREEN, RESET, test_name);
+        tests_passed++;
+    }
+    else
+    {
+        printf("%s[FAIL]%s %s\n", RED, RESET, test_name);
+        tests_failed++;
+    }
+}
+
+void assert_false(int condition, const char *test_name)
+{
+    assert_true(!condition, test_name);
+}
+
+int main()
+{
+    printf("=== Starting Arena Parsing Tests ===\n");
+
+    // TEST 1: Arena and heap parses produce the same document
+    {
+        printf("\n--- Test: Arena Round Trip ---\n");
+        const char *json = "{\"name\":\"Radikant\",\"tags\":[\"a\",\"b\\n\",\"\\u00e9\"],"
+                           "\"n\":-12.5,\"ok\":true,\"nil\":null,\"nested\":{\"x\":[[],{}]}}";
+        rjson_arena *arena = rjson_arena_new(0);
+        assert_true(arena != NULL, "Should create an arena");
+
+        rjson_value *heap_doc = rjson_parse(json);
+        rjson_value *arena_doc = rjson_parse_arena(arena, json);
+        assert_true(arena_doc != NULL, "Should parse into the arena");
+
+        char *heap_out = NULL;
+        char *arena_out = NULL;
+        rjson_serialize(heap_doc, &heap_out, NULL);
+        rjson_serialize(arena_doc, &arena_out, NULL);
+        assert_true(heap_out && arena_out && strcmp(heap_out, arena_out) == 0,
+                    "Arena document should serialize identically to heap document");
+
+        free(heap_out);
+        free(arena_out);
+        rjson_free(heap_doc);
+        rjson_free(arena_doc); // Must be a harmless no-op
+        assert_true(1, "rjson_free on an arena document should be a no-op");
+        rjson_arena_free(arena);
+    }
+
+    // TEST 2: Large arrays grow correctly inside small chunks
+    {
+        printf("\n--- Test: Arena Growth ---\n");
+        const int count = 10000;
+        char *json = (char *)malloc((size_t)count * 8 + 16);
+        char *p = json;
+        *p++ = '[';
+        for (int i = 0; i < count; i++)
+            p += sprintf(p, i ? ",%d" : "%d", i);
+        *p++ = ']';
+        *p = '\0';
+
+        rjson_arena *arena = rjson_arena_new(256); // Force many chunks
+        rjson_value *doc = rjson_parse_arena(arena, json);
+        int ok = doc && doc->type == RJSON_ARRAY && doc->as.arr_val.count == (size_t)count;
+        for (int i = 0; ok && i < count; i++)
+            ok = doc->as.arr_val.elements[i]->as.num_val == (double)i;
+        assert_true(ok, "Should parse 10000 elements in order with tiny chunks");
+        rjson_arena_free(arena);
+        free(json);
+    }
+
+    // TEST 3: Reset and reuse across documents
+    {
+        printf("\n--- Test: Arena Reset ---\n");
+        rjson_arena *arena = rjson_arena_new(0);
+        int ok = 1;
+        for (int i = 0; i < 100 && ok; i++)
+        {
+            rjson_value *doc = rjson_parse_arena(arena, "{\"id\": 7, \"name\": \"worker\"}");
+            rjson_value *name = rjson_object_get_value(doc, "name");
+            ok = name && strcmp(name->as.str_val, "worker") == 0;
+            rjson_arena_reset(arena);
+        }
+        assert_true(ok, "Should reuse the arena across 100 parses");
+        rjson_arena_free(arena);
+    }
+
+    // TEST 4: Failures and read-only containers
+    {
+        printf("\n--- Test: Arena Errors ---\n");
+        rjson_arena *arena = rjson_arena_new(0);
+        assert_false(rjson_parse_arena(arena, "[1, 2,") != NULL, "Should reject truncated input");
+        assert_false(rjson_parse_arena(NULL, "[]") != NULL, "Should reject NULL arena");
+
+        rjson_value *doc = rjson_parse_arena(arena, "[1]");
+        rjson_value *extra = rjson_number_new(2);
+        assert_true(rjson_array_add(doc, extra) == -1, "Arena containers should be read-only");
+        rjson_free(extra);
+        rjson_arena_free(arena);
+    }
+
+    printf("\n=== Summary ===\n");
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return (tests_failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,142 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h> // For strcmp
+#include "rjson.h"
+
+// ANSI Color codes
+#define GREEN "\033[0;32m"
+#define RED "\033[0;31m"
+#define RESET "\033[0m"
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+void assert_true(int condition, const char *test_name)
+{
+    if (condition)
+    {
+        printf("%s[PASS]%s %s\n", GREEN, RESET, test_name);
+        tests_passed++;
+    }
+    else
+    {
+        printf("%s[FAIL]%s %s\n", RED, RESET, test_name);
+        tests_failed++;
+    }
+}
+
+void assert_false(int condition, const char *test_name)
+{
+    assert_true(!condition, test_name);
+}
+
+
+int main()
+{
+    printf("=== Starting Cursor Tests ===\n");
+
+    // TEST 1: Reading a few fields out of an envelope
+    {
+        printf("\n--- Test: Field Lookup ---\n");
+        const char *json = "{\"meta\": {\"trace\": [1, {\"x\": \"]}\"}], \"ok\": true}, \"payload\": \"skip me\", "
+                           "\"ro\\u0075te\": \"eu-west\", \"retries\": 3, \"weight\": 0.25, \"big\": 9007199254740993}";
+        rjson_cursor root, field;
+        assert_true(rjson_cursor_init(&root, json, strlen(json)) == 0, "Should open the document");
+
+        const char *str = NULL;
+        size_t len = 0;
+        assert_true(rjson_cursor_find_field(&root, "route", &field) == 0 &&
+                        rjson_cursor_get_string_view(&field, &str, &len) == 0 && len == 7 && memcmp(str, "eu-west", 7) == 0,
+                    "Should match an escaped key and view its string");
+        assert_true(str >= json && str < json + strlen(json), "String view should point into the input");
+
+        int64_t i = 0;
+        double d = 0;
+        int b = 0;
+        assert_true(rjson_cursor_find_field(&root, "retries", &field) == 0 && rjson_cursor_get_int64(&field, &i) == 0 && i == 3,
+                    "Should read an integer field");
+        assert_true(rjson_cursor_find_field(&root, "weight", &field) == 0 && rjson_cursor_get_double(&field, &d) == 0 && d == 0.25,
+                    "Should read a double field");
+        assert_true(rjson_cursor_find_field(&root, "big", &field) == 0 && rjson_cursor_get_int64(&field, &i) == 0 &&
+                        i == 9007199254740993LL,
+                    "Should read a 64-bit integer exactly");
+        assert_false(rjson_cursor_get_int64(&root, &i) == 0, "An object is not a number");
+
+        rjson_cursor meta, ok;
+        assert_true(rjson_cursor_find_field(&root, "meta", &meta) == 0 && rjson_cursor_find_field(&meta, "ok", &ok) == 0 &&
+                        rjson_cursor_get_bool(&ok, &b) == 0 && b == 1,
+                    "Should descend into nested objects past brackets inside strings");
+        assert_false(rjson_cursor_find_field(&root, "missing", &field) == 0, "Should report a missing field");
+        assert_false(rjson_cursor_find_field(&meta, "route", &field) == 0, "Should not search outside the object");
+    }
+
+    // TEST 2: Array iteration
+    {
+        printf("\n--- Test: Array Iteration ---\n");
+        const char *json = "[ {\"id\": 1, \"tags\": [\"a\", \"b\"]}, 2.5, \"s\", null, [[]], {\"id\": 6} ]";
+        rjson_cursor root, item;
+        rjson_cursor_init(&root, json, strlen(json));
+        rjson_type types[8];
+        int count = 0;
+        for (int rc = rjson_cursor_first_element(&root, &item); rc == 0 && count < 8; rc = rjson_cursor_next_element(&item))
+            rjson_cursor_get_type(&item, &types[count++]);
+        assert_true(count == 6, "Should visit every element");
+        assert_true(count == 6 && types[0] == RJSON_OBJECT && types[1] == RJSON_NUMBER && types[2] == RJSON_STRING &&
+                        types[3] == RJSON_NULL && types[4] == RJSON_ARRAY && types[5] == RJSON_OBJECT,
+                    "Should report element types");
+
+        rjson_cursor empty;
+        rjson_cursor_init(&empty, " [ ] ", 5);
+        assert_false(rjson_cursor_first_element(&empty, &item) == 0, "An empty array has no elements");
+    }
+
+    // TEST 3: Skipping large subtrees with tricky strings at every block offset
+    {
+        printf("\n--- Test: Subtree Skipping ---\n");
+        int ok = 1;
+        for (int pad = 0; pad < 130 && ok; pad++)
+        {
+            char json[1024];
+            int n = sprintf(json, "{\"skip\": [\"%*s\", {\"a\": \"\\\\\"}, \"\\\"]}\", [[{}]], \"\\\\\\\\[\"], \"want\": 42}", pad, "");
+            rjson_cursor root, want;
+            int64_t v = 0;
+            ok = rjson_cursor_init(&root, json, (size_t)n) == 0 && rjson_cursor_find_field(&root, "want", &want) == 0 &&
+                 rjson_cursor_get_int64(&want, &v) == 0 && v == 42;
+        }
+        assert_true(ok, "Should skip escaped quotes, backslashes and brackets in strings");
+
+        const char *truncated = "{\"skip\": [1, [2, 3], \"want\": 1";
+        rjson_cursor root, want;
+        rjson_cursor_init(&root, truncated, strlen(truncated));
+        assert_false(rjson_cursor_find_field(&root, "want", &want) == 0, "Should stop at the end of truncated input");
+    }
+
+    // TEST 4: Materializing a subtree
+    {
+        printf("\n--- Test: Subtree Values ---\n");
+        const char *json = "{\"user\": {\"name\": \"a\\tb\", \"ids\": [1, 2]}, \"tail\": 0}";
+        rjson_cursor root, user, name;
+        rjson_cursor_init(&root, json, strlen(json));
+        rjson_cursor_find_field(&root, "user", &user);
+        rjson_cursor_find_field(&user, "name", &name);
+
+        const char *str = NULL;
+        assert_false(rjson_cursor_get_string_view(&name, &str, NULL) == 0, "Escaped strings cannot be viewed");
+        rjson_value *val = rjson_cursor_get_value(&name, NULL);
+        assert_true(val && strcmp(val->as.str_val, "a\tb") == 0, "Should decode an escaped string");
+        rjson_free(val);
+
+        val = rjson_cursor_get_value(&user, NULL);
+        char *out = NULL;
+        rjson_serialize(val, &out, NULL);
+        assert_true(out && strcmp(out, "{\"name\":\"a\\tb\",\"ids\":[1,2]}") == 0, "Should parse a whole subtree");
+        free(out);
+        rjson_free(val);
+    }
+
+    printf("\n=== Summary ===\n");
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return (tests_failed == 0) ? 0 : 1;
+}
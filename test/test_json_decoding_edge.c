@@ -266,7 +266,7 @@ int main()
         printf("\n--- Test: Deeply Nested Objects ---\n");
         int depth = 600;
         // Construct {"a":{"a": ... }}
-        char* deep_json = (char*)malloc(depth * 6 + 1);
+        char* deep_json = (char*)malloc(depth * 6 + 2);
         if (deep_json) {
             char* p = deep_json;
             for(int i=0; i<depth; i++) {
@@ -491,6 +491,347 @@ int main()
         }
     }
 
+    // TEST 32: Configurable Depth Limit
+    // Nesting is tracked on the heap, so a raised limit admits very deep documents.
+    {
+        printf("\n--- Test: Configurable Depth Limit ---\n");
+        int depth = 100000;
+        char *deep_json = (char *)malloc((size_t)depth * 6 + 2);
+        if (deep_json)
+        {
+            char *p = deep_json;
+            for (int i = 0; i < depth; i++)
+            {
+                if (i % 2)
+                    p += sprintf(p, "{\"a\":");
+                else
+                    *p++ = '[';
+            }
+            *p++ = '1';
+            for (int i = depth - 1; i >= 0; i--)
+                *p++ = (i % 2) ? '}' : ']';
+            *p = '\0';
+
+            rjson_parse_options options = {0};
+            options.max_depth = 200000;
+            rjson_value *val = rjson_parse_ex(deep_json, strlen(deep_json), &options);
+            assert_true(val != NULL, "Should parse 100000 levels with a raised limit");
+            char *out = NULL;
+            assert_true(val && rjson_serialize(val, &out, NULL) == 0 && strcmp(out, deep_json) == 0,
+                        "Should serialize 100000 levels back unchanged");
+            free(out);
+            rjson_free(val);
+
+            val = rjson_parse(deep_json);
+            assert_false(val != NULL, "Should reject 100000 levels with the default limit");
+            rjson_free(val);
+            free(deep_json);
+        }
+
+        rjson_parse_options options = {0};
+        options.max_depth = 3;
+        rjson_value *val = rjson_parse_ex("[[[1]]]", 7, &options);
+        assert_true(val != NULL, "Should accept nesting at the limit");
+        rjson_free(val);
+        val = rjson_parse_ex("[[{\"a\":[]}]]", 13, &options);
+        assert_false(val != NULL, "Should reject nesting past the limit");
+        rjson_free(val);
+    }
+
+    // TEST 33: Children in Order Across Nesting
+    // Children are collected on one pending list and handed to each
+    // container when it closes; siblings at different depths must not mix.
+    {
+        printf("\n--- Test: Children in Order Across Nesting ---\n");
+        const char *json = "{\"a\":[1,[2,3],{\"b\":4,\"c\":[]},5],\"d\":{},\"e\":6}";
+        rjson_value *val = rjson_parse(json);
+        char *out = NULL;
+        assert_true(val && rjson_serialize(val, &out, NULL) == 0 && strcmp(out, json) == 0,
+                    "Should rebuild mixed nesting exactly");
+        free(out);
+
+        rjson_value *a = rjson_object_get_value(val, "a");
+        assert_true(a && a->as.arr_val.count == 4, "Inner array should hold its own 4 elements");
+        assert_true(rjson_array_add(a, rjson_null_new()) == 0 && a->as.arr_val.count == 5,
+                    "Parsed arrays should accept new elements");
+        assert_true(rjson_object_add(val, "f", rjson_bool_new(1)) == 0 &&
+                        rjson_object_get_value(val, "f") != NULL,
+                    "Parsed objects should accept new members");
+        rjson_free(val);
+
+        val = rjson_parse("[[1,2],{\"k\":[3,{\"x\":\"y\"}]},");
+        assert_false(val != NULL, "Should release pending children of an unfinished document");
+        rjson_free(val);
+    }
+
+    // TEST 34: Short strings stored inside the node (RJSON_PARSE_INLINE_STRINGS)
+    // Every form must read the same through rjson_string_get(); without the
+    // flag, str_val stays valid for every string.
+    {
+        printf("\n--- Test: Inline Short Strings ---\n");
+        const char *json = "[\"\",\"ok\",\"en-US\",\"123456789012345\",\"1234567890123456\",\"t\\u00e9\",\"a longer string value\"]";
+        const char *expected[] = {"", "ok", "en-US", "123456789012345", "1234567890123456", "t\xC3\xA9", "a longer string value"};
+        rjson_arena *arena = rjson_arena_new(0);
+        rjson_parse_options options = {0};
+        options.flags = RJSON_PARSE_INLINE_STRINGS;
+        rjson_value *docs[3] = {rjson_parse_ex(json, strlen(json), &options), NULL, rjson_parse(json)};
+        options.arena = arena;
+        docs[1] = rjson_parse_ex(json, strlen(json), &options);
+
+        int ok = docs[0] && docs[1] && docs[2];
+        for (int d = 0; ok && d < 3; d++)
+        {
+            for (size_t i = 0; ok && i < 7; i++)
+            {
+                size_t len = 0;
+                const char *s = rjson_string_get(docs[d]->as.arr_val.elements[i], &len);
+                ok = s && len == strlen(expected[i]) && strcmp(s, expected[i]) == 0;
+            }
+        }
+        assert_true(ok, "Short and long strings should read back identically");
+
+        ok = docs[2] != NULL;
+        for (size_t i = 0; ok && i < 7; i++)
+        {
+            const rjson_value *str = docs[2]->as.arr_val.elements[i];
+            ok = str->as.str_val && strcmp(str->as.str_val, expected[i]) == 0;
+        }
+        assert_true(ok, "Without the flag every string should have a str_val");
+        assert_true(docs[0] && docs[0]->as.arr_val.elements[1]->as.str_val == NULL &&
+                        docs[0]->as.arr_val.elements[6]->as.str_val != NULL,
+                    "Only short strings should be stored inline");
+
+        char *out = NULL;
+        assert_true(docs[0] && rjson_serialize(docs[0], &out, NULL) == 0 &&
+                        strcmp(out, "[\"\",\"ok\",\"en-US\",\"123456789012345\",\"1234567890123456\",\"t\xC3\xA9\",\"a longer string value\"]") == 0,
+                    "Inline strings should serialize like any other");
+        free(out);
+
+        rjson_value copy = *docs[0]->as.arr_val.elements[2];
+        rjson_free(docs[0]);
+        rjson_free(docs[2]);
+        const char *copied = rjson_string_get(&copy, NULL);
+        assert_true(copied && strcmp(copied, "en-US") == 0, "A copied short string should not depend on the original node");
+        rjson_arena_free(arena);
+
+        rjson_value *built = rjson_string_new("GET");
+        rjson_value *quoted = rjson_string_new("\"\n\"");
+        char *a = NULL;
+        char *b = NULL;
+        assert_true(built && built->as.str_val && strcmp(built->as.str_val, "GET") == 0,
+                    "Built strings should have a str_val");
+        assert_true(built && rjson_serialize(built, &a, NULL) == 0 && strcmp(a, "\"GET\"") == 0 &&
+                        rjson_serialize(quoted, &b, NULL) == 0 && strcmp(b, "\"\\\"\\n\\\"\"") == 0,
+                    "Built short strings should be stored and escaped correctly");
+        free(a);
+        free(b);
+        rjson_free(built);
+        rjson_free(quoted);
+    }
+
+    // TEST 35: Literal nodes
+    {
+        printf("\n--- Test: Literal Nodes ---\n");
+        rjson_value *doc = rjson_parse("[true, true, null, false]");
+        rjson_value **e = doc ? doc->as.arr_val.elements : NULL;
+        assert_true(e && e[0]->type == RJSON_BOOL && e[0]->as.bool_val == 1 && e[2]->type == RJSON_NULL &&
+                        e[3]->as.bool_val == 0,
+                    "Literals should keep their types and values");
+        if (e)
+            e[0]->as.bool_val = 0; // Heap literals are private and writable
+        assert_true(e && e[0] != e[1] && e[1]->as.bool_val == 1, "Writing one heap literal should not change another");
+        rjson_value *other = rjson_parse("true");
+        assert_true(other && other->as.bool_val == 1, "Writing a literal should not affect later documents");
+        rjson_free(other);
+        rjson_free(doc);
+
+        rjson_arena *arena = rjson_arena_new(0);
+        rjson_value *first = rjson_parse_arena(arena, "[null, true, false, null, true, false]");
+        rjson_value *second = rjson_parse_arena(arena, "{\"a\": true, \"b\": null}");
+        e = first ? first->as.arr_val.elements : NULL;
+        assert_true(e && e[0] != e[3] && e[1] != e[4] && e[2] != e[5],
+                    "Arena literals should each get their own node");
+        assert_true(e && e[0]->type == RJSON_NULL && e[1]->as.bool_val == 1 && e[2]->as.bool_val == 0,
+                    "Arena literals should keep their types and values");
+        if (e)
+            e[1]->as.bool_val = 0;
+        assert_true(e && e[4]->as.bool_val == 1 && second && rjson_object_get_value(second, "a")->as.bool_val == 1,
+                    "Writing one arena literal should not change another");
+        rjson_arena_free(arena);
+
+        rjson_value *own = rjson_bool_new(1);
+        own->as.bool_val = 0; // Built nodes are always private
+        assert_true(own->type == RJSON_BOOL && own->as.bool_val == 0, "Built literals should be writable");
+        rjson_free(own);
+    }
+
+    // TEST 36: Length-carrying keys and strings
+    {
+        printf("\n--- Test: Keys and Strings by Length ---\n");
+        rjson_value *obj = rjson_parse("{\"id\": 1, \"identity\": 2, \"i\\\"d\": 3}");
+        size_t len = 0;
+        assert_true(obj && strcmp(rjson_object_get_key(obj, 1, &len), "identity") == 0 && len == 8,
+                    "Key accessor should return the key and its length");
+        assert_true(obj && rjson_object_get_key(obj, 2, &len) && len == 3 && rjson_object_get_key(obj, 3, NULL) == NULL,
+                    "Escaped key lengths should be decoded lengths; out of range is NULL");
+        assert_true(rjson_object_get_value_n(obj, "identity", 2)->as.num_val == 1 &&
+                        rjson_object_get_value_n(obj, "identity", 8)->as.num_val == 2 &&
+                        rjson_object_get_value_n(obj, "iden", 4) == NULL,
+                    "Lookups should match the whole key by length");
+
+        rjson_value *four = rjson_number_new(4);
+        assert_true(rjson_object_add_n(obj, "k\0ey", 4, four) != 0 && rjson_object_get_value_n(obj, "k\0ey", 4) == NULL,
+                    "Keys containing NUL should be rejected");
+        assert_true(rjson_object_add_n(obj, "key!", 3, four) == 0 && rjson_object_get_value(obj, "key") == four &&
+                        rjson_object_get_value(obj, "i\"d")->as.num_val == 3,
+                    "Added keys should be cut to their length");
+        char *json = NULL;
+        assert_true(rjson_serialize(obj, &json, NULL) == 0 && strcmp(json, "{\"id\":1,\"identity\":2,\"i\\\"d\":3,\"key\":4}") == 0,
+                    "Keys should serialize in full");
+        free(json);
+        rjson_free(obj);
+
+        rjson_value *str = rjson_string_new_n("a\0b", 3);
+        json = NULL;
+        assert_true(str->as.str_len == 3 && rjson_serialize(str, &json, NULL) == 0 && strcmp(json, "\"a\\u0000b\"") == 0,
+                    "rjson_string_new_n() should keep embedded NUL");
+        free(json);
+        rjson_free(str);
+
+        rjson_parse_options opts = {RJSON_PARSE_ALLOW_NUL, NULL, 0};
+        const char *nul_doc = "{\"ab\": \"x\\u0000yz\"}";
+        rjson_value *nul = rjson_parse_ex(nul_doc, strlen(nul_doc), &opts);
+        const char *s = nul ? rjson_string_get(rjson_object_get_value(nul, "ab"), &len) : NULL;
+        assert_true(s && len == 4 && memcmp(s, "x\0yz", 4) == 0,
+                    "RJSON_PARSE_ALLOW_NUL should decode \\u0000 in strings");
+        rjson_free(nul);
+        nul_doc = "{\"a\\u0000b\": 1}";
+        assert_true(rjson_parse_ex(nul_doc, strlen(nul_doc), &opts) == NULL, "Keys should never decode to NUL");
+
+        // Keys are measured when used: trimming `count`, replacing a key or
+        // building the arrays by hand must keep lookups working
+        rjson_value *trimmed = rjson_parse("{\"aa\":1,\"b\":2,\"c\":3}");
+        rjson_value *dropped = trimmed->as.obj_val.values[2];
+        trimmed->as.obj_val.count = 2;
+        assert_true(rjson_object_get_value(trimmed, "b")->as.num_val == 2 && rjson_object_get_value(trimmed, "c") == NULL,
+                    "Lookups should follow a lowered count");
+        free(trimmed->as.obj_val.keys[0]);
+        trimmed->as.obj_val.keys[0] = (char *)malloc(5);
+        memcpy(trimmed->as.obj_val.keys[0], "long", 5);
+        json = NULL;
+        assert_true(rjson_object_get_value(trimmed, "long")->as.num_val == 1 && rjson_object_get_value(trimmed, "aa") == NULL &&
+                        rjson_serialize(trimmed, &json, NULL) == 0 && strcmp(json, "{\"long\":1,\"b\":2}") == 0,
+                    "A key replaced by hand should be found and serialized at its own length");
+        free(json);
+        rjson_free(dropped);
+        free(trimmed->as.obj_val.keys[2]);
+        rjson_free(trimmed);
+
+        rjson_value *manual = rjson_object_new();
+        manual->as.obj_val.keys = (char **)malloc(sizeof(char *));
+        manual->as.obj_val.values = (rjson_value **)malloc(sizeof(rjson_value *));
+        manual->as.obj_val.keys[0] = (char *)malloc(5);
+        memcpy(manual->as.obj_val.keys[0], "name", 5);
+        manual->as.obj_val.values[0] = rjson_bool_new(1);
+        manual->as.obj_val.count = 1;
+        json = NULL;
+        assert_true(rjson_object_get_value(manual, "name") != NULL &&
+                        rjson_object_add(manual, "id", rjson_number_new(7)) == 0 &&
+                        rjson_serialize(manual, &json, NULL) == 0 && strcmp(json, "{\"name\":true,\"id\":7}") == 0,
+                    "Objects built by hand should work with the API");
+        free(json);
+        rjson_free(manual);
+    }
+
+    // TEST 37: Hashed key lookup in wide objects
+    {
+        printf("\n--- Test: Wide Object Lookup ---\n");
+        enum { WIDE = 20000 };
+        size_t cap = (size_t)WIDE * 24 + 64;
+        char *json = (char *)malloc(cap);
+        size_t n = 0;
+        json[n++] = '{';
+        for (int i = 0; i < WIDE; i++)
+            n += (size_t)snprintf(json + n, cap - n, "%s\"key%d\":%d", i ? "," : "", i, i);
+        n += (size_t)snprintf(json + n, cap - n, ",\"key7\":-1}"); // Duplicate: the first one wins
+
+        rjson_parse_options intern = {RJSON_PARSE_INTERN_KEYS, NULL, 0};
+        rjson_value *docs[3] = {rjson_parse_n(json, n), rjson_parse_ex(json, n, &intern),
+                                rjson_parse_parallel(json, n, 4, NULL)};
+        int found = 1;
+        char key[32];
+        for (int d = 0; d < 3; d++)
+        {
+            for (int i = 0; i < WIDE && found; i++)
+            {
+                snprintf(key, sizeof(key), "key%d", i);
+                rjson_value *v = rjson_object_get_value(docs[d], key);
+                found = v && v->as.num_val == i;
+            }
+            found = found && rjson_object_get_value(docs[d], "key") == NULL &&
+                    rjson_object_get_value(docs[d], "key20000") == NULL;
+        }
+        assert_true(found, "Every key of a wide object should be found, duplicates by their first member");
+
+        rjson_value *tail = rjson_number_new(1);
+        assert_true(rjson_object_add(docs[1], "added", tail) == 0 && rjson_object_get_value(docs[1], "added") == tail &&
+                        rjson_object_get_value(docs[1], "key19999")->as.num_val == 19999,
+                    "Adding to a parsed wide object should keep its keys findable");
+        for (int d = 0; d < 3; d++)
+            rjson_free(docs[d]);
+        free(json);
+
+        // Built objects get their index once they grow past a few members
+        rjson_value *obj = rjson_object_new();
+        found = 1;
+        for (int i = 0; i < 300 && found; i++)
+        {
+            snprintf(key, sizeof(key), "k%d", i);
+            found = rjson_object_add(obj, key, rjson_number_new(i)) == 0;
+            for (int j = 0; j <= i && found; j++)
+            {
+                snprintf(key, sizeof(key), "k%d", j);
+                rjson_value *v = rjson_object_get_value(obj, key);
+                found = v && v->as.num_val == j;
+            }
+        }
+        assert_true(found && rjson_object_get_value(obj, "k300") == NULL,
+                    "Lookups should stay exact while a built object grows");
+        size_t len;
+        assert_true(strcmp(rjson_object_get_key(obj, 0, &len), "k0") == 0 &&
+                        strcmp(rjson_object_get_key(obj, 299, &len), "k299") == 0 && len == 4,
+                    "Members should keep their insertion order");
+        assert_true(obj->as.obj_val.index != NULL, "A wide built object should carry its hash index");
+
+        // Hand edits of the public fields: replace a key, lower the count,
+        // then append by hand
+        free(obj->as.obj_val.keys[50]);
+        obj->as.obj_val.keys[50] = (char *)malloc(8);
+        memcpy(obj->as.obj_val.keys[50], "swapped", 8);
+        assert_true(rjson_object_get_value(obj, "swapped") == obj->as.obj_val.values[50] &&
+                        rjson_object_get_value(obj, "k50") == NULL && rjson_object_get_value(obj, "k51")->as.num_val == 51,
+                    "Lookups should notice a key replaced by hand");
+        for (size_t i = 200; i < 300; i++)
+        {
+            free(obj->as.obj_val.keys[i]);
+            rjson_free(obj->as.obj_val.values[i]);
+        }
+        obj->as.obj_val.count = 200;
+        assert_true(rjson_object_get_value(obj, "k199")->as.num_val == 199 && rjson_object_get_value(obj, "k250") == NULL,
+                    "Lookups should follow a count lowered by hand");
+        obj->as.obj_val.keys[200] = (char *)malloc(6);
+        memcpy(obj->as.obj_val.keys[200], "extra", 6);
+        obj->as.obj_val.values[200] = rjson_null_new();
+        obj->as.obj_val.count = 201;
+        assert_true(rjson_object_get_value(obj, "extra") != NULL && rjson_object_get_value(obj, "k200") == NULL,
+                    "Lookups should scan members added by hand");
+        assert_true(rjson_object_add(obj, "late", rjson_number_new(1)) == 0 && rjson_object_get_value(obj, "late") != NULL &&
+                        rjson_object_get_value(obj, "extra") != NULL && rjson_object_get_value(obj, "swapped") != NULL &&
+                        rjson_object_get_value(obj, "k0")->as.num_val == 0,
+                    "rjson_object_add() should rebuild the index from the current members");
+        rjson_free(obj);
+    }
+
     printf("\n=== Summary ===\n");
     printf("Passed: %d\n", tests_passed);
     printf("Failed: %d\n", tests_failed);
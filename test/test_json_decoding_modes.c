@@ -0,0 +1,351 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h> // For strcmp
+#include "rjson.h"
+
+// ANSI Color codes
+#define GREEN "\033[0;32m"
+#define RED "\033[0;31m"
+#define RESET "\033[0m"
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+void assert_true(int condition, const char *test_name)
+{
+    if (condition)
+    {
+        printf("%s[PASS]%s %s\n", GREEN, RESET, test_name);
+        tests_passed++;
+    }
+    else
+    {
+        printf("%s[FAIL]%s %s\n", RED, RESET, test_name);
+        tests_failed++;
+    }
+}
+
+void assert_false(int condition, const char *test_name)
+{
+    assert_true(!condition, test_name);
+}
+
+// Copies `json` into an exact-size heap block with no terminator, so any
+// read past the end is caught by sanitizers.
+// Writes `len` bytes of `data` to `path`. Returns 0 or -1.
+static int write_file(const char *path, const char *data, size_t len)
+{
+    FILE *f = fopen(path, "wb");
+    if (!f)
+        return -1;
+    size_t written = fwrite(data, 1, len, f);
+    return (fclose(f) == 0 && written == len) ? 0 : -1;
+}
+
+static char *unterminated_copy(const char *json, size_t *len)
+{
+    *len = strlen(json);
+    char *buf = (char *)malloc(*len ? *len : 1);
+    memcpy(buf, json, *len);
+    return buf;
+}
+
+int main()
+{
+    printf("=== Starting Decoding Mode Tests ===\n");
+
+    // TEST 1: Length-delimited parsing of unterminated buffers
+    // Every token type ends exactly at the end of the buffer.
+    {
+        printf("\n--- Test: rjson_parse_n Without Terminator ---\n");
+        const char *docs[] = {"123", "-0.5e3", "true", "null", "\"abc\"",
+                              "[1,2]", "{\"a\":\"b\"}", "  false  ", NULL};
+        for (int i = 0; docs[i]; i++)
+        {
+            size_t len;
+            char *buf = unterminated_copy(docs[i], &len);
+            rjson_value *val = rjson_parse_n(buf, len);
+            assert_true(val != NULL, docs[i]);
+            rjson_free(val);
+            free(buf);
+        }
+    }
+
+    // TEST 2: Truncated tokens at the end of the buffer must fail
+    {
+        printf("\n--- Test: rjson_parse_n Truncation ---\n");
+        const char *docs[] = {"tru", "nul", "\"abc", "\"ab\\", "[1,", "{\"a\"", "-", "1e", NULL};
+        for (int i = 0; docs[i]; i++)
+        {
+            size_t len;
+            char *buf = unterminated_copy(docs[i], &len);
+            rjson_value *val = rjson_parse_n(buf, len);
+            assert_false(val != NULL, docs[i]);
+            rjson_free(val);
+            free(buf);
+        }
+    }
+
+    // TEST 3: The length bounds the document, not the terminator
+    {
+        printf("\n--- Test: rjson_parse_n Prefix ---\n");
+        const char *json = "[10, 20] trailing garbage";
+        rjson_value *val = rjson_parse_n(json, 8);
+        assert_true(val && val->type == RJSON_ARRAY && val->as.arr_val.count == 2, "Should parse only the first 8 bytes");
+        rjson_free(val);
+
+        val = rjson_parse_n("[1]\0[2]", 7);
+        assert_false(val != NULL, "Should reject an embedded NUL byte");
+        rjson_free(val);
+    }
+
+    // TEST 4: Padded input contract
+    // Padding bytes look like valid string content and must never be consumed.
+    {
+        printf("\n--- Test: Padded Input ---\n");
+        const char *json = "{\"message\": \"a fairly long string value\"}";
+        size_t len = strlen(json);
+        char *buf = (char *)malloc(len + RJSON_PADDING);
+        memcpy(buf, json, len);
+        memset(buf + len, 'x', RJSON_PADDING);
+
+        rjson_parse_options options = {0};
+        options.flags = RJSON_PARSE_PADDED;
+        rjson_value *val = rjson_parse_ex(buf, len, &options);
+        rjson_value *msg = rjson_object_get_value(val, "message");
+        assert_true(msg && strcmp(msg->as.str_val, "a fairly long string value") == 0, "Should parse padded input");
+        rjson_free(val);
+
+        // Cut the document inside the string: the padding must not complete it
+        val = rjson_parse_ex(buf, 20, &options);
+        assert_false(val != NULL, "Should not read string content from the padding");
+        rjson_free(val);
+        free(buf);
+    }
+
+    // TEST 5: In-situ parsing
+    // Strings and keys must point into the donated buffer.
+    {
+        printf("\n--- Test: In-situ Parsing ---\n");
+        const char *json = "{\"plain\": \"value\", \"esc\\\"key\": \"tab\\there \\u00e9\\ud83d\\ude00\", \"list\": [\"x\"]}";
+        size_t len;
+        char *buf = unterminated_copy(json, &len);
+        rjson_value *val = rjson_parse_insitu(buf, len, NULL);
+        assert_true(val != NULL, "Should parse a writable buffer in place");
+
+        rjson_value *plain = rjson_object_get_value(val, "plain");
+        assert_true(plain && strcmp(plain->as.str_val, "value") == 0, "Should decode a plain string");
+        assert_true(plain && plain->as.str_val >= buf && plain->as.str_val < buf + len, "String should live in the input buffer");
+
+        rjson_value *esc = rjson_object_get_value(val, "esc\"key");
+        assert_true(esc && strcmp(esc->as.str_val, "tab\there \xC3\xA9\xF0\x9F\x98\x80") == 0, "Should decode escapes in place");
+
+        // Adding a heap key to an in-situ object must not confuse ownership
+        assert_true(rjson_object_add(val, "added", rjson_null_new()) == 0, "Should add a key to an in-situ object");
+
+        char *out = NULL;
+        rjson_serialize(val, &out, NULL);
+        assert_true(out && strcmp(out, "{\"plain\":\"value\",\"esc\\\"key\":\"tab\\there \xC3\xA9\xF0\x9F\x98\x80\","
+                                       "\"list\":[\"x\"],\"added\":null}") == 0,
+                    "Should serialize the in-situ document");
+        free(out);
+        rjson_free(val);
+        free(buf);
+    }
+
+    // TEST 6: In-situ parsing into an arena
+    {
+        printf("\n--- Test: In-situ Arena Parsing ---\n");
+        char buf[] = "[\"a\", {\"k\": \"v\\n\"}]";
+        rjson_arena *arena = rjson_arena_new(0);
+        rjson_parse_options options = {0};
+        options.arena = arena;
+        rjson_value *val = rjson_parse_insitu(buf, strlen(buf), &options);
+        rjson_value *inner = val ? rjson_object_get_value(val->as.arr_val.elements[1], "k") : NULL;
+        assert_true(inner && strcmp(inner->as.str_val, "v\n") == 0, "Should combine in-situ strings with arena nodes");
+        rjson_arena_free(arena);
+
+        char bad[] = "[\"unterminated]";
+        val = rjson_parse_insitu(bad, strlen(bad), NULL);
+        assert_false(val != NULL, "Should reject malformed in-situ input");
+        rjson_free(val);
+    }
+
+    // TEST 7: Zero-copy string views
+    // Escape-free strings reference the input, escaped ones are materialized.
+    {
+        printf("\n--- Test: Zero-copy Views ---\n");
+        const char *json = "{\"id\": \"abc123\", \"msg\": \"line\\nbreak\", \"tags\": [\"x\", \"\"]}";
+        size_t len;
+        char *buf = unterminated_copy(json, &len);
+        rjson_parse_options options = {0};
+        options.flags = RJSON_PARSE_ZEROCOPY;
+        rjson_value *val = rjson_parse_ex(buf, len, &options);
+        assert_true(val != NULL, "Should parse in zero-copy mode");
+
+        size_t str_len = 0;
+        const char *id = rjson_string_get(rjson_object_get_value(val, "id"), &str_len);
+        assert_true(id >= buf && id < buf + len, "Escape-free string should be a view of the input");
+        assert_true(str_len == 6 && memcmp(id, "abc123", 6) == 0, "View should carry its length");
+
+        const char *msg = rjson_string_get(rjson_object_get_value(val, "msg"), &str_len);
+        assert_true(!(msg >= buf && msg < buf + len), "Escaped string should be materialized");
+        assert_true(str_len == 10 && strcmp(msg, "line\nbreak") == 0, "Materialized string should be decoded");
+
+        char *out = NULL;
+        size_t out_len = 0;
+        rjson_serialize(val, &out, &out_len);
+        assert_true(out && strcmp(out, "{\"id\":\"abc123\",\"msg\":\"line\\nbreak\",\"tags\":[\"x\",\"\"]}") == 0,
+                    "Should serialize views by length");
+        free(out);
+        rjson_free(val);
+        free(buf);
+    }
+
+    // TEST 8: Arena cleanup tied to the input lifetime
+    {
+        printf("\n--- Test: Zero-copy Arena Lifetime ---\n");
+        size_t len;
+        char *buf = unterminated_copy("[\"keep me alive\"]", &len);
+        rjson_arena *arena = rjson_arena_new(0);
+        rjson_parse_options options = {0};
+        options.flags = RJSON_PARSE_ZEROCOPY;
+        options.arena = arena;
+        rjson_value *val = rjson_parse_ex(buf, len, &options);
+        assert_true(val && rjson_arena_add_cleanup(arena, free, buf) == 0, "Should hand the input to the arena");
+
+        size_t str_len = 0;
+        const char *s = rjson_string_get(val->as.arr_val.elements[0], &str_len);
+        assert_true(str_len == 13 && memcmp(s, "keep me alive", 13) == 0, "View should stay valid while the arena lives");
+        rjson_arena_free(arena); // Releases buf
+    }
+
+    // TEST 9: Escape-heavy strings longer than the initial decode buffer
+    {
+        printf("\n--- Test: Long Escaped Strings ---\n");
+        char json[8192];
+        char expect[4096];
+        char *p = json;
+        char *e = expect;
+        p += sprintf(p, "{\"k\\u00e9y\\n\": \"");
+        for (int i = 0; i < 200; i++)
+        {
+            p += sprintf(p, "ab\\t\\u20ac\\ud83d\\ude00");
+            e += sprintf(e, "ab\t\xE2\x82\xAC\xF0\x9F\x98\x80");
+        }
+        sprintf(p, "\"}");
+
+        rjson_value *val = rjson_parse(json);
+        rjson_value *s = rjson_object_get_value(val, "k\xC3\xA9y\n");
+        assert_true(s && s->as.str_len == strlen(expect) && strcmp(s->as.str_val, expect) == 0,
+                    "Should decode escaped keys and a long escaped value");
+        rjson_free(val);
+
+        val = rjson_parse_insitu(json, strlen(json), NULL);
+        s = rjson_object_get_value(val, "k\xC3\xA9y\n");
+        assert_true(s && strcmp(s->as.str_val, expect) == 0, "Should decode the same string in place");
+        rjson_free(val);
+    }
+
+    // TEST 10: Parsing straight from a file
+    {
+        printf("\n--- Test: File Parsing ---\n");
+        const char *path = "rjson_test_file.json";
+        const char *json = "{\"name\": \"mapped\", \"esc\": \"a\\tb\", \"n\": 1.25}";
+        assert_true(write_file(path, json, strlen(json)) == 0, "Should write the test file");
+
+        rjson_value *val = rjson_parse_file(path, NULL);
+        rjson_value *name = rjson_object_get_value(val, "name");
+        assert_true(name && strcmp(name->as.str_val, "mapped") == 0, "Should parse a file");
+        rjson_free(val);
+
+        // Heap documents copy their strings even when views are requested
+        rjson_parse_options options = {0};
+        options.flags = RJSON_PARSE_ZEROCOPY | RJSON_PARSE_LAZY_NUMBERS;
+        val = rjson_parse_file(path, &options);
+        name = rjson_object_get_value(val, "name");
+        assert_true(name && strcmp(name->as.str_val, "mapped") == 0, // NUL-terminated: not a view
+                    "Heap documents should not reference the file");
+        rjson_free(val);
+
+        // Arena documents keep referencing the file until the arena goes
+        rjson_arena *arena = rjson_arena_new(0);
+        options.arena = arena;
+        val = rjson_parse_file(path, &options);
+        size_t len = 0;
+        const char *s = rjson_string_get(rjson_object_get_value(val, "name"), &len);
+        assert_true(s && len == 6 && memcmp(s, "mapped", 6) == 0, "Should keep a view of the file in an arena");
+        assert_true(rjson_number_get_double(rjson_object_get_value(val, "n")) == 1.25, "Should convert lazy numbers");
+        rjson_arena_free(arena);
+
+        // A document filling a whole page has no readable bytes after it
+        char page[4096];
+        memset(page, ' ', sizeof(page));
+        memcpy(page, "[\"", 2);
+        memset(page + 2, 'x', sizeof(page) - 4);
+        memcpy(page + sizeof(page) - 2, "\"]", 2);
+        assert_true(write_file(path, page, sizeof(page)) == 0, "Should write a page-sized file");
+        val = rjson_parse_file(path, NULL);
+        assert_true(val && val->as.arr_val.elements[0]->as.str_len == sizeof(page) - 4, "Should parse a page-sized file");
+        rjson_free(val);
+
+        page[sizeof(page) - 1] = ' ';
+        write_file(path, page, sizeof(page));
+        assert_false(rjson_parse_file(path, NULL) != NULL, "Should reject a truncated file");
+        write_file(path, "", 0);
+        assert_false(rjson_parse_file(path, NULL) != NULL, "Should reject an empty file");
+        remove(path);
+        assert_false(rjson_parse_file(path, NULL) != NULL, "Should fail on a missing file");
+    }
+
+    // TEST 11: Interned keys
+    {
+        printf("\n--- Test: Interned Keys ---\n");
+        const char *json = "[{\"id\":1,\"name\":\"a\",\"n\\u0061me2\":{\"id\":2}},{\"id\":3,\"name\":\"b\",\"name2\":{}}]";
+        rjson_parse_options options = {0};
+        options.flags = RJSON_PARSE_INTERN_KEYS;
+        rjson_value *val = rjson_parse_ex(json, strlen(json), &options);
+        assert_true(val != NULL, "Should parse with interned keys");
+
+        rjson_value *first = val->as.arr_val.elements[0];
+        rjson_value *second = val->as.arr_val.elements[1];
+        rjson_value *nested = rjson_object_get_value(first, "name2");
+        assert_true(first->as.obj_val.keys[0] == second->as.obj_val.keys[0] &&
+                        first->as.obj_val.keys[0] == nested->as.obj_val.keys[0],
+                    "Repeated keys should share one copy");
+        assert_true(first->as.obj_val.keys[2] == second->as.obj_val.keys[2],
+                    "Escaped and plain spellings of a key should intern together");
+        assert_true(rjson_object_get_value(second, first->as.obj_val.keys[1]) == second->as.obj_val.values[1],
+                    "Should look up by a key of another object");
+
+        char *out = NULL;
+        rjson_serialize(val, &out, NULL);
+        assert_true(out && strcmp(out, "[{\"id\":1,\"name\":\"a\",\"name2\":{\"id\":2}},{\"id\":3,\"name\":\"b\",\"name2\":{}}]") == 0,
+                    "Interned document should serialize unchanged");
+        free(out);
+
+        // Adding to one object must not disturb the keys the others share
+        assert_true(rjson_object_add(first, "extra", rjson_null_new()) == 0, "Should add to an interned object");
+        assert_true(strcmp(second->as.obj_val.keys[0], "id") == 0 && strcmp(nested->as.obj_val.keys[0], "id") == 0,
+                    "Shared keys should survive a copy-on-add");
+        rjson_free(val);
+
+        rjson_arena *arena = rjson_arena_new(0);
+        options.arena = arena;
+        val = rjson_parse_ex(json, strlen(json), &options);
+        assert_true(val && val->as.arr_val.elements[0]->as.obj_val.keys[1] == val->as.arr_val.elements[1]->as.obj_val.keys[1],
+                    "Should intern keys in an arena");
+        assert_false(rjson_parse_ex("[{\"id\":1},{\"id\":", 16, &options) != NULL, "Should reject a truncated document");
+        rjson_arena_free(arena);
+
+        options.arena = NULL;
+        assert_false(rjson_parse_ex("[{\"id\":1},{\"id\":2,\"x\"", 22, &options) != NULL,
+                     "Should release shared keys of a rejected document");
+    }
+
+    printf("\n=== Summary ===\n");
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return (tests_failed == 0) ? 0 : 1;
+}
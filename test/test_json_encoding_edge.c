@@ -36,7 +36,8 @@ int main()
     printf("=== Starting Hardened JSON Encoding Tests ===\n");
 
     // TEST 1: Serialization Stack Exhaustion
-    // Manually construct a deep tree and try to serialize it.
+    // Manually construct a deep tree and serialize it. Open containers are
+    // kept on the heap, so depth is not bounded by the C stack.
     {
         printf("\n--- Test: Stack Exhaustion ---\n");
         rjson_value *root = rjson_array_new();
@@ -51,11 +52,14 @@ int main()
         }
 
         char *out = NULL;
-        int result = rjson_serialize(root, &out, NULL);
+        size_t len = 0;
+        int result = rjson_serialize(root, &out, &len);
 
-        assert_true(result == -1, "Should fail gracefully on deep recursion");
-        assert_true(out == NULL, "Output should be NULL on failure");
+        assert_true(result == 0, "Should serialize deep nesting without recursion");
+        assert_true(out && len == 2 * (size_t)(depth + 1) && out[depth] == '[' && out[depth + 1] == ']',
+                    "Deep output should be complete");
 
+        free(out);
         rjson_free(root);
     }
 
@@ -0,0 +1,197 @@
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h> // For strcmp
+#include "rjson.h"
+
+// ANSI Color codes
+#define GREEN "\033[0;32m"
+#define RED "\033[0;31m"
+#define RESET "\033[0m"
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+void assert_true(int condition, const char *test_name)
+{
+    if (condition)
+    {
+        printf("%s[PASS]%s %s\n", GREEN, RESET, test_name);
+        tests_passed++;
+    }
+    else
+    {
+        printf("%s[FAIL]%s %s\n", RED, RESET, test_name);
+        tests_failed++;
+    }
+}
+
+void assert_false(int condition, const char *test_name)
+{
+    assert_true(!condition, test_name);
+}
+
+
+// Builds `count` records of the form {"id": i, ...}, one per line
+static char *make_records(int count, size_t *len)
+{
+    char *data = (char *)malloc((size_t)count * 96 + 1);
+    char *p = data;
+    for (int i = 0; i < count; i++)
+        p += sprintf(p, "{\"id\": %d, \"name\": \"rec\\n%d\", \"vals\": [%d.5, true, null]}\n", i, i, i % 100);
+    *len = (size_t)(p - data);
+    return data;
+}
+
+// Marks every record it sees; `seen` has one slot per record
+struct seen_records
+{
+    unsigned char *seen;
+    size_t count;
+    int ids_match;
+    size_t stop_at;
+};
+
+static int mark_record(void *ctx, size_t index, rjson_value *doc)
+{
+    struct seen_records *s = (struct seen_records *)ctx;
+    if (index >= s->count)
+        return 1;
+    s->seen[index]++; // Each index is delivered once, so no two threads share a slot
+    rjson_value *id = rjson_object_get_value(doc, "id");
+    if (!id || id->as.num_val != (double)index)
+        s->ids_match = 0;
+    return index == s->stop_at;
+}
+
+// Stops the parse at record 0 once another worker is busy further on, and
+// counts the records delivered after that
+struct stop_records
+{
+    atomic_int busy;
+    atomic_int stopped;
+    atomic_size_t late;
+};
+
+static int stop_record(void *ctx, size_t index, rjson_value *doc)
+{
+    (void)doc;
+    struct stop_records *s = (struct stop_records *)ctx;
+    if (atomic_load(&s->stopped))
+        atomic_fetch_add(&s->late, 1);
+    if (index >= 2000)
+        atomic_store(&s->busy, 1); // Beyond the first chunks: another worker
+    if (index != 0)
+        return 0;
+    for (int i = 0; i < 1000000 && !atomic_load(&s->busy); i++)
+        sched_yield();
+    atomic_store(&s->stopped, 1);
+    return 1;
+}
+
+int main()
+{
+    printf("=== Starting NDJSON Tests ===\n");
+
+    // TEST 1: Record boundaries
+    {
+        printf("\n--- Test: Record Boundaries ---\n");
+        const char *data = "{\"a\": 1}\r\n\n   \n[1, 2]\n{\"bad\": }\n\"last\"";
+        rjson_ndjson_batch *batch = rjson_ndjson_parse(data, strlen(data), NULL);
+        assert_true(batch && rjson_ndjson_count(batch) == 4, "Should skip blank lines and count 4 records");
+        assert_true(rjson_ndjson_error_count(batch) == 1 && rjson_ndjson_get(batch, 2) == NULL,
+                    "Should report the invalid record");
+        rjson_value *first = rjson_ndjson_get(batch, 0);
+        rjson_value *last = rjson_ndjson_get(batch, 3);
+        assert_true(first && rjson_object_get_value(first, "a") != NULL, "Should accept a CRLF line ending");
+        assert_true(last && strcmp(last->as.str_val, "last") == 0, "Should parse a final line without newline");
+        assert_true(rjson_ndjson_get(batch, 4) == NULL, "Out of range index should be NULL");
+        rjson_ndjson_free(batch);
+
+        batch = rjson_ndjson_parse("", 0, NULL);
+        assert_true(batch && rjson_ndjson_count(batch) == 0, "Empty input has no records");
+        rjson_ndjson_free(batch);
+
+        // A huge thread count is capped for a one-chunk input
+        rjson_ndjson_options many = {0};
+        many.threads = 100000;
+        batch = rjson_ndjson_parse(data, strlen(data), &many);
+        assert_true(batch && rjson_ndjson_count(batch) == 4, "Should parse a small input with a huge thread count");
+        rjson_ndjson_free(batch);
+    }
+
+    // TEST 2: Multithreaded results match a single thread, in order
+    {
+        printf("\n--- Test: Parallel Batch ---\n");
+        const int count = 50000;
+        size_t len;
+        char *data = make_records(count, &len);
+
+        rjson_ndjson_options single = {0};
+        single.threads = 1;
+        rjson_ndjson_options parallel = {0};
+        parallel.threads = 4;
+        rjson_ndjson_batch *a = rjson_ndjson_parse(data, len, &single);
+        rjson_ndjson_batch *b = rjson_ndjson_parse(data, len, &parallel);
+        assert_true(a && b && rjson_ndjson_count(a) == (size_t)count && rjson_ndjson_count(b) == (size_t)count,
+                    "Should parse every record");
+
+        int same = 1;
+        for (int i = 0; same && i < count; i++)
+        {
+            char *sa = NULL;
+            char *sb = NULL;
+            rjson_serialize(rjson_ndjson_get(a, (size_t)i), &sa, NULL);
+            rjson_serialize(rjson_ndjson_get(b, (size_t)i), &sb, NULL);
+            rjson_value *id = rjson_object_get_value(rjson_ndjson_get(b, (size_t)i), "id");
+            same = sa && sb && strcmp(sa, sb) == 0 && id && id->as.num_val == (double)i;
+            free(sa);
+            free(sb);
+        }
+        assert_true(same, "Parallel records should match and keep input order");
+        rjson_ndjson_free(a);
+        rjson_ndjson_free(b);
+        free(data);
+    }
+
+    // TEST 3: Streaming to a callback
+    {
+        printf("\n--- Test: Streaming ---\n");
+        const int count = 20000;
+        size_t len;
+        char *data = make_records(count, &len);
+        struct seen_records s = {0};
+        s.seen = (unsigned char *)calloc((size_t)count, 1);
+        s.count = (size_t)count;
+        s.ids_match = 1;
+        s.stop_at = (size_t)-1;
+
+        rjson_ndjson_options options = {0};
+        options.threads = 4;
+        assert_true(rjson_ndjson_each(data, len, &options, mark_record, &s) == 0, "Should stream every record");
+        int once = 1;
+        for (int i = 0; i < count; i++)
+            once &= s.seen[i] == 1;
+        assert_true(once && s.ids_match, "Each record should arrive once with its index");
+
+        s.stop_at = 100;
+        assert_false(rjson_ndjson_each(data, len, &options, mark_record, &s) == 0, "A callback should stop the parse");
+
+        // The other workers stop at their next record, not at the end of their chunk
+        struct stop_records stop;
+        atomic_init(&stop.busy, 0);
+        atomic_init(&stop.stopped, 0);
+        atomic_init(&stop.late, 0);
+        assert_false(rjson_ndjson_each(data, len, &options, stop_record, &stop) == 0, "A callback should stop the parse");
+        assert_true(atomic_load(&stop.late) < 64, "Stopping should reach the other workers promptly");
+        free(s.seen);
+        free(data);
+    }
+
+    printf("\n=== Summary ===\n");
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return (tests_failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,205 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h> // For strcmp
+#include "rjson.h"
+
+// ANSI Color codes
+#define GREEN "\033[0;32m"
+#define RED "\033[0;31m"
+#define RESET "\033[0m"
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+void assert_true(int condition, const char *test_name)
+{
+    if (condition)
+    {
+        printf("%s[PASS]%s %s\n", GREEN, RESET, test_name);
+        tests_passed++;
+    }
+    else
+    {
+        printf("%s[FAIL]%s %s\n", RED, RESET, test_name);
+        tests_failed++;
+    }
+}
+
+void assert_false(int condition, const char *test_name)
+{
+    assert_true(!condition, test_name);
+}
+
+// Returns 1 if `json` parses to a number bit-identical to strtod()'s
+// correctly rounded result (the test runs in the "C" locale).
+static int parses_exactly(const char *json)
+{
+    rjson_value *val = rjson_parse(json);
+    double expected = strtod(json, NULL);
+    int ok = val && val->type == RJSON_NUMBER && memcmp(&val->as.num_val, &expected, sizeof(double)) == 0;
+    rjson_free(val);
+    return ok;
+}
+
+int main()
+{
+    printf("=== Starting Number Parsing Tests ===\n");
+
+    // TEST 1: Hard rounding cases
+    {
+        printf("\n--- Test: Correct Rounding ---\n");
+        const char *docs[] = {
+            "0.1",
+            "-0",
+            "9007199254740993",                                        // 2^53 + 1: ties to even
+            "1e23",                                                    // Not exact in the fast path
+            "2.2250738585072011e-308",                                 // Largest subnormal
+            "2.2250738585072012e-308",                                 // Rounds up to the smallest normal
+            "4.9406564584124654e-324",                                 // Smallest subnormal
+            "1.7976931348623157e308",                                  // DBL_MAX
+            "1.00000000000000011102230246251565404236316680908203125", // Exact halfway: ties to even
+            "1.00000000000000011102230246251565404236316680908203126", // Just above halfway
+            "123456789012345678901234567890e-10",                      // More than 19 digits
+            "0.000000000000000000000000000000000000000000001234567890123456789012",
+            NULL};
+        for (int i = 0; docs[i]; i++)
+            assert_true(parses_exactly(docs[i]), docs[i]);
+    }
+
+    // TEST 2: Round trip of many generated doubles
+    {
+        printf("\n--- Test: Round Trip ---\n");
+        unsigned long long state = 88172645463325252ULL;
+        int ok = 1;
+        for (int i = 0; i < 100000 && ok; i++)
+        {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            double d;
+            unsigned long long bits = state & 0x7FEFFFFFFFFFFFFFULL; // Finite values only
+            memcpy(&d, &bits, sizeof(d));
+            char buf[64];
+            snprintf(buf, sizeof(buf), (i & 1) ? "%.17g" : "%.6e", d);
+            ok = parses_exactly(buf);
+            if (!ok)
+                printf("  mismatch on %s\n", buf);
+        }
+        assert_true(ok, "Should match correctly rounded conversion for 100000 values");
+    }
+
+    // TEST 3: Range limits
+    {
+        printf("\n--- Test: Range ---\n");
+        rjson_value *val = rjson_parse("[1e-400, -1e-400, 5e-324]");
+        assert_true(val && val->as.arr_val.elements[0]->as.num_val == 0.0, "Should underflow to zero");
+        assert_true(val && val->as.arr_val.elements[2]->as.num_val > 0.0, "Should keep the smallest subnormal");
+        rjson_free(val);
+
+        const char *overflows[] = {"1.8e308", "-1e309", "123456789012345678901234567890e300", NULL};
+        for (int i = 0; overflows[i]; i++)
+        {
+            val = rjson_parse(overflows[i]);
+            assert_false(val != NULL, overflows[i]);
+            rjson_free(val);
+        }
+    }
+
+    // TEST 4: Grammar
+    {
+        printf("\n--- Test: Number Grammar ---\n");
+        const char *invalid[] = {"01", "-", "1.", ".5", "1e", "1e+", "+1", "0x10", "1.5e", "--1", NULL};
+        for (int i = 0; invalid[i]; i++)
+        {
+            rjson_value *val = rjson_parse(invalid[i]);
+            assert_false(val != NULL, invalid[i]);
+            rjson_free(val);
+        }
+        rjson_value *val = rjson_parse("[0, -0.0, 12345678, 1E+2, 1e-0]");
+        assert_true(val && val->as.arr_val.count == 5 && val->as.arr_val.elements[3]->as.num_val == 100.0,
+                    "Should accept valid number forms");
+        rjson_free(val);
+    }
+
+    // TEST 5: 64-bit integers keep their exact value
+    {
+        printf("\n--- Test: 64-bit Integers ---\n");
+        const char *json = "[9007199254740993, -9223372036854775808, 18446744073709551615, "
+                           "18446744073709551616, 1.0, -0, 0, 1e2]";
+        rjson_value *val = rjson_parse(json);
+        assert_true(val && val->as.arr_val.count == 8, "Should parse the integer array");
+        rjson_value **e = val->as.arr_val.elements;
+
+        int64_t i = 0;
+        uint64_t u = 0;
+        assert_true(rjson_number_get_kind(e[0]) == RJSON_NUMBER_INT64 && e[0]->as.int_val == 9007199254740993LL,
+                    "Should keep 2^53 + 1 exact");
+        assert_true(rjson_number_get_int64(e[1], &i) == 0 && i == INT64_MIN, "Should parse INT64_MIN");
+        assert_true(rjson_number_get_kind(e[2]) == RJSON_NUMBER_UINT64 && e[2]->as.uint_val == UINT64_MAX,
+                    "Should parse UINT64_MAX as unsigned");
+        assert_false(rjson_number_get_int64(e[2], &i) == 0, "UINT64_MAX should not fit int64");
+        assert_true(rjson_number_get_kind(e[3]) == RJSON_NUMBER_DOUBLE, "Should fall back to double beyond 64 bits");
+        assert_true(rjson_number_get_kind(e[4]) == RJSON_NUMBER_DOUBLE && rjson_number_get_uint64(e[4], &u) == 0 && u == 1,
+                    "1.0 should be a double that converts exactly");
+        assert_true(rjson_number_get_kind(e[5]) == RJSON_NUMBER_DOUBLE, "-0 should stay a double");
+        assert_true(rjson_number_get_kind(e[6]) == RJSON_NUMBER_INT64 && e[6]->as.num_val == 0.0, "0 should be an integer");
+
+        char *out = NULL;
+        rjson_serialize(val, &out, NULL);
+        assert_true(out && strcmp(out, "[9007199254740993,-9223372036854775808,18446744073709551615,"
+                                       "1.8446744073709552e+19,1,-0,0,100]") == 0,
+                    "Should serialize integers exactly");
+        free(out);
+        rjson_free(val);
+
+        val = rjson_array_new();
+        rjson_array_add(val, rjson_int64_new(-42));
+        rjson_array_add(val, rjson_uint64_new(12345678901234567890ULL));
+        rjson_serialize(val, &out, NULL);
+        assert_true(out && strcmp(out, "[-42,12345678901234567890]") == 0, "Should serialize constructed integers");
+        free(out);
+        rjson_free(val);
+    }
+
+    // TEST 6: Lazy numbers convert on first access and otherwise round-trip verbatim
+    {
+        printf("\n--- Test: Lazy Numbers ---\n");
+        const char *json = "{\"price\": 1.50, \"id\": 12345678901234567890, \"neg\": -0.000, \"big\": 2.5E+3}";
+        rjson_parse_options options = {0};
+        options.flags = RJSON_PARSE_LAZY_NUMBERS;
+        rjson_value *val = rjson_parse_ex(json, strlen(json), &options);
+        assert_true(val != NULL, "Should parse with lazy numbers");
+
+        char *out = NULL;
+        rjson_serialize(val, &out, NULL);
+        assert_true(out && strcmp(out, "{\"price\":1.50,\"id\":12345678901234567890,\"neg\":-0.000,\"big\":2500}") == 0,
+                    "Untouched numbers should keep their original text");
+        free(out);
+
+        rjson_value *price = rjson_object_get_value(val, "price");
+        assert_true(rjson_number_get_double(price) == 1.5, "Should convert on first access");
+        uint64_t id = 0;
+        assert_true(rjson_number_get_uint64(rjson_object_get_value(val, "id"), &id) == 0 && id == 12345678901234567890ULL,
+                    "Lazy integers should keep their exact value");
+
+        rjson_serialize(val, &out, NULL);
+        assert_true(out && strcmp(out, "{\"price\":1.5,\"id\":12345678901234567890,\"neg\":-0.000,\"big\":2500}") == 0,
+                    "Converted numbers should serialize from their value");
+        free(out);
+        rjson_free(val);
+
+        const char *invalid[] = {"[01]", "[1.]", "[-]", "[1e999]", NULL};
+        for (int i = 0; invalid[i]; i++)
+        {
+            val = rjson_parse_ex(invalid[i], strlen(invalid[i]), &options);
+            assert_false(val != NULL, invalid[i]);
+            rjson_free(val);
+        }
+    }
+
+    printf("\n=== Summary ===\n");
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return (tests_failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,187 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h> // For strcmp
+#include "rjson.h"
+
+// ANSI Color codes
+#define GREEN "\033[0;32m"
+#define RED "\033[0;31m"
+#define RESET "\033[0m"
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+void assert_true(int condition, const char *test_name)
+{
+    if (condition)
+    {
+        printf("%s[PASS]%s %s\n", GREEN, RESET, test_name);
+        tests_passed++;
+    }
+    else
+    {
+        printf("%s[FAIL]%s %s\n", RED, RESET, test_name);
+        tests_failed++;
+    }
+}
+
+void assert_false(int condition, const char *test_name)
+{
+    assert_true(!condition, test_name);
+}
+
+// Builds a document of `count` records, large enough to be split: an array
+// of objects, or an object whose members are the records.
+static char *make_document(int count, int as_object, size_t *len)
+{
+    char *data = (char *)malloc((size_t)count * 128 + 16);
+    char *p = data;
+    *p++ = as_object ? '{' : '[';
+    for (int i = 0; i < count; i++)
+    {
+        if (i > 0)
+            p += sprintf(p, (i % 7) ? ",\n  " : ",");
+        if (as_object)
+            p += sprintf(p, "\"key\\u00e9%d\": ", i);
+        p += sprintf(p, "{\"id\": %d, \"name\": \"rec\\\"%d\", \"vals\": [%d.5, true, null, [\"]\"]]}", i, i, i % 100);
+    }
+    *p++ = as_object ? '}' : ']';
+    *p = '\0';
+    *len = (size_t)(p - data);
+    return data;
+}
+
+// Returns 1 if the parallel and sequential parses agree: both fail, or
+// both succeed and serialize identically.
+static int same_as_sequential(const char *json, size_t len, unsigned int threads, const rjson_parse_options *options)
+{
+    rjson_value *seq = rjson_parse_ex(json, len, options);
+    rjson_value *par = rjson_parse_parallel(json, len, threads, options);
+    int same = (seq == NULL) == (par == NULL);
+    if (same && seq)
+    {
+        char *a = NULL;
+        char *b = NULL;
+        rjson_serialize(seq, &a, NULL);
+        rjson_serialize(par, &b, NULL);
+        same = a && b && strcmp(a, b) == 0;
+        free(a);
+        free(b);
+    }
+    rjson_free(seq);
+    rjson_free(par);
+    return same;
+}
+
+int main()
+{
+    printf("=== Starting Parallel Parsing Tests ===\n");
+
+    // TEST 1: Large arrays and objects match the sequential parse
+    {
+        printf("\n--- Test: Same Tree As Sequential ---\n");
+        size_t len;
+        char *json = make_document(20000, 0, &len);
+        rjson_value *val = rjson_parse_parallel(json, len, 4, NULL);
+        assert_true(val && val->type == RJSON_ARRAY && val->as.arr_val.count == 20000, "Should parse every element");
+        rjson_value *last = val ? val->as.arr_val.elements[19999] : NULL;
+        assert_true(last && rjson_object_get_value(last, "id")->as.num_val == 19999.0, "Should keep elements in order");
+        rjson_free(val);
+        assert_true(same_as_sequential(json, len, 4, NULL), "Array should match the sequential parse");
+        assert_true(same_as_sequential(json, len, 3, NULL), "Should not depend on the thread count");
+        free(json);
+
+        json = make_document(20000, 1, &len);
+        val = rjson_parse_parallel(json, len, 4, NULL);
+        assert_true(val && val->type == RJSON_OBJECT && val->as.obj_val.count == 20000, "Should parse every member");
+        assert_true(val && rjson_object_get_value(val, "key\xC3\xA9" "12345") != NULL, "Should decode member keys");
+        rjson_free(val);
+        assert_true(same_as_sequential(json, len, 4, NULL), "Object should match the sequential parse");
+        free(json);
+    }
+
+    // TEST 2: Arena documents
+    {
+        printf("\n--- Test: Arena ---\n");
+        size_t len;
+        char *json = make_document(20000, 1, &len);
+        rjson_arena *arena = rjson_arena_new(0);
+        rjson_parse_options options = {0};
+        options.arena = arena;
+        options.flags = RJSON_PARSE_ZEROCOPY | RJSON_PARSE_LAZY_NUMBERS;
+        rjson_value *val = rjson_parse_parallel(json, len, 4, &options);
+        assert_true(val && val->as.obj_val.count == 20000, "Should parse into an arena");
+        assert_true(same_as_sequential(json, len, 4, &options), "Should match the sequential arena parse");
+        rjson_arena_reset(arena);
+        assert_true(same_as_sequential(json, len, 4, &options), "Should reuse the arena after a reset");
+        rjson_arena_free(arena); // Also releases the workers' arenas
+        free(json);
+    }
+
+    // TEST 3: Errors anywhere are detected exactly as by the sequential parser
+    {
+        printf("\n--- Test: Error Detection ---\n");
+        size_t len;
+        char *json = make_document(20000, 0, &len);
+        const char *mid = strstr(json + len / 2, "true");
+        size_t at = (size_t)(mid - json);
+
+        json[at] = 'T'; // Invalid literal inside one chunk
+        assert_true(same_as_sequential(json, len, 4, NULL), "Should reject an invalid element");
+        json[at] = 't';
+
+        json[len - 1] = ' '; // Unterminated root
+        assert_true(same_as_sequential(json, len, 4, NULL), "Should reject a missing closing bracket");
+        json[len - 1] = ']';
+
+        char *comma = strchr(json + len / 3, ',');
+        while (comma[1] != '{')
+            comma = strchr(comma + 1, ',');
+        *comma = ' '; // Missing separator between two top-level elements
+        assert_true(same_as_sequential(json, len, 4, NULL), "Should reject a missing comma");
+        *comma = ',';
+
+        json[len - 1] = ',';
+        assert_true(same_as_sequential(json, len, 4, NULL), "Should reject a truncated document");
+        json[len - 1] = ']';
+
+        char *garbage = (char *)malloc(len + 3);
+        memcpy(garbage, json, len);
+        memcpy(garbage + len, " x", 3);
+        assert_true(same_as_sequential(garbage, len + 2, 4, NULL), "Should reject trailing garbage");
+        free(garbage);
+
+        rjson_parse_options options = {0};
+        options.max_depth = 3; // Root, record, "vals" array: the inner ["]"] is one level too deep
+        assert_true(same_as_sequential(json, len, 4, &options), "Should apply the depth limit to the children");
+        options.max_depth = 4;
+        assert_true(same_as_sequential(json, len, 4, &options), "Should accept the exact depth");
+        free(json);
+    }
+
+    // TEST 4: Inputs that are not split
+    {
+        printf("\n--- Test: Sequential Fallback ---\n");
+        const char *small = "[1, {\"a\": [true]}, \"x\"]";
+        assert_true(same_as_sequential(small, strlen(small), 4, NULL), "Small documents should parse sequentially");
+        assert_false(rjson_parse_parallel("[1, 2,]", 7, 4, NULL) != NULL, "Should reject a trailing comma");
+
+        size_t len;
+        char *json = make_document(20000, 0, &len);
+        char *str = (char *)malloc(len + 3);
+        str[0] = '"';
+        for (size_t i = 0; i < len; i++)
+            str[i + 1] = (json[i] == '"' || json[i] == '\\') ? '\'' : json[i];
+        str[len + 1] = '"';
+        assert_true(same_as_sequential(str, len + 2, 4, NULL), "A scalar root should parse sequentially");
+        assert_true(same_as_sequential(json, len, 1, NULL), "One thread should parse sequentially");
+        free(str);
+        free(json);
+    }
+
+    printf("\n=== Summary ===\n");
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return (tests_failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,167 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h> // For strcmp
+#include "rjson.h"
+
+// ANSI Color codes
+#define GREEN "\033[0;32m"
+#define RED "\033[0;31m"
+#define RESET "\033[0m"
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+void assert_true(int condition, const char *test_name)
+{
+    if (condition)
+    {
+        printf("%s[PASS]%s %s\n", GREEN, RESET, test_name);
+        tests_passed++;
+    }
+    else
+    {
+        printf("%s[FAIL]%s %s\n", RED, RESET, test_name);
+        tests_failed++;
+    }
+}
+
+void assert_false(int condition, const char *test_name)
+{
+    assert_true(!condition, test_name);
+}
+
+
+// Parses `len` bytes with a push parser fed `chunk` bytes at a time.
+static rjson_value *push_parse(const char *json, size_t len, size_t chunk, const rjson_parse_options *options)
+{
+    rjson_push_parser *parser = rjson_push_parser_new(options);
+    if (!parser)
+        return NULL;
+    for (size_t i = 0; i < len; i += chunk)
+    {
+        size_t n = (len - i < chunk) ? len - i : chunk;
+        if (rjson_push_feed(parser, json + i, n) != 0)
+            break;
+    }
+    rjson_value *val = rjson_push_finish(parser);
+    rjson_push_parser_free(parser);
+    return val;
+}
+
+// Returns 1 if pushing `json` in every chunk size agrees with rjson_parse_n()
+// on validity and on the serialized tree.
+static int push_matches_parse(const char *json)
+{
+    size_t len = strlen(json);
+    rjson_value *expected = rjson_parse_n(json, len);
+    char *want = NULL;
+    if (expected)
+        rjson_serialize(expected, &want, NULL);
+    rjson_free(expected);
+
+    int same = 1;
+    for (size_t chunk = 1; chunk <= len + 1 && same; chunk++)
+    {
+        rjson_value *val = push_parse(json, len, chunk, NULL);
+        char *got = NULL;
+        if (val)
+            rjson_serialize(val, &got, NULL);
+        same = want ? (got && strcmp(want, got) == 0) : (val == NULL);
+        free(got);
+        rjson_free(val);
+    }
+    free(want);
+    return same;
+}
+
+int main()
+{
+    printf("=== Starting Push Parser Tests ===\n");
+
+    // TEST 1: Every chunk size builds the same tree as a one-shot parse
+    // Splits land inside strings, escapes, surrogate pairs, numbers and literals.
+    {
+        printf("\n--- Test: Chunk Boundaries ---\n");
+        const char *docs[] = {
+            "{\"name\": \"caf\\u00e9 \\\"quoted\\\" \\\\\", \"emoji\": \"\\ud83d\\ude00\", \"list\": [1, -2.5e-3, 12345678901234567890]}",
+            "[true, false, null, {}, [], \"\", {\"a\": {\"b\": [[\"deep\"]]}}]",
+            "  \"top-level string with \\n escape\"  ",
+            "-0.000123e+10",
+            "18446744073709551615",
+            "\xEF\xBB\xBF{\"bom\": true}",
+            NULL};
+        for (int i = 0; docs[i]; i++)
+            assert_true(push_matches_parse(docs[i]), docs[i]);
+    }
+
+    // TEST 2: Malformed input fails in every chunking
+    {
+        printf("\n--- Test: Invalid Input ---\n");
+        const char *docs[] = {"[1,]", "{\"a\" 1}", "[truex]", "[1.2.3]", "[\"open", "\"\\x\"", "[1] 2",
+                              "{\"a\":1", "", "   ", "01", "\"\\ud800\"", "[\"tab\there\"]", "nul", "\xEF\xBB", NULL};
+        for (int i = 0; docs[i]; i++)
+            assert_true(push_matches_parse(docs[i]), docs[i]);
+    }
+
+    // TEST 3: Errors are sticky and a finished parser accepts no more input
+    {
+        printf("\n--- Test: Parser State ---\n");
+        rjson_push_parser *parser = rjson_push_parser_new(NULL);
+        assert_true(rjson_push_feed(parser, "[1, ", 4) == 0, "Should accept a partial document");
+        assert_false(rjson_push_feed(parser, "}", 1) == 0, "Should reject a mismatched bracket");
+        assert_false(rjson_push_feed(parser, "2]", 2) == 0, "Should stay failed");
+        assert_false(rjson_push_finish(parser) != NULL, "Should not return a document after an error");
+        rjson_push_parser_free(parser);
+
+        parser = rjson_push_parser_new(NULL);
+        rjson_push_feed(parser, "{\"a\": [1, 2", 11);
+        rjson_push_parser_free(parser); // Releases the partial tree
+
+        parser = rjson_push_parser_new(NULL);
+        rjson_push_feed(parser, "4", 1);
+        rjson_push_feed(parser, "2", 1);
+        rjson_value *val = rjson_push_finish(parser);
+        assert_true(val && val->as.num_val == 42.0, "End of input should complete a top-level number");
+        assert_false(rjson_push_feed(parser, " ", 1) == 0, "Should not accept input after finishing");
+        rjson_push_parser_free(parser);
+        rjson_free(val);
+    }
+
+    // TEST 4: A large document in network-sized chunks, into an arena
+    {
+        printf("\n--- Test: Arena and Depth Limit ---\n");
+        const int count = 20000;
+        char *json = (char *)malloc((size_t)count * 64 + 16);
+        char *p = json;
+        *p++ = '[';
+        for (int i = 0; i < count; i++)
+            p += sprintf(p, "%s{\"id\": %d, \"tag\": \"item\\t%d\"}", i ? ", " : "", i, i);
+        *p++ = ']';
+        size_t len = (size_t)(p - json);
+
+        rjson_arena *arena = rjson_arena_new(0);
+        rjson_parse_options options = {0};
+        options.arena = arena;
+        rjson_value *val = push_parse(json, len, 1460, &options);
+        rjson_value *last = val ? rjson_object_get_value(val->as.arr_val.elements[count - 1], "tag") : NULL;
+        assert_true(val && val->as.arr_val.count == (size_t)count, "Should parse 20000 records");
+        assert_true(last && strcmp(last->as.str_val, "item\t19999") == 0, "Should decode the last record");
+        rjson_arena_free(arena);
+        free(json);
+
+        options.arena = NULL;
+        options.max_depth = 2;
+        val = push_parse("[[1]]", 5, 1, &options);
+        assert_true(val != NULL, "Should accept nesting at the limit");
+        rjson_free(val);
+        val = push_parse("[[[1]]]", 7, 1, &options);
+        assert_false(val != NULL, "Should reject nesting past the limit");
+        rjson_free(val);
+    }
+
+    printf("\n=== Summary ===\n");
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return (tests_failed == 0) ? 0 : 1;
+}
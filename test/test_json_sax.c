@@ -0,0 +1,216 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h> // For strcmp
+#include "rjson.h"
+
+// ANSI Color codes
+#define GREEN "\033[0;32m"
+#define RED "\033[0;31m"
+#define RESET "\033[0m"
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+void assert_true(int condition, const char *test_name)
+{
+    if (condition)
+    {
+        printf("%s[PASS]%s %s\n", GREEN, RESET, test_name);
+        tests_passed++;
+    }
+    else
+    {
+        printf("%s[FAIL]%s %s\n", RED, RESET, test_name);
+        tests_failed++;
+    }
+}
+
+void assert_false(int condition, const char *test_name)
+{
+    assert_true(!condition, test_name);
+}
+
+
+// Records every event as compact text, e.g. {k:"v"[1,T,N]}
+struct recorder
+{
+    char text[512];
+    size_t len;
+    const char *input; // Set to count strings that point into the input
+    size_t input_len;
+    int views;
+};
+
+static int record(struct recorder *r, const char *s, size_t n)
+{
+    if (r->len + n < sizeof(r->text))
+    {
+        memcpy(r->text + r->len, s, n);
+        r->len += n;
+        r->text[r->len] = '\0';
+    }
+    return RJSON_SAX_CONTINUE;
+}
+
+static int on_start_object(void *ctx) { return record((struct recorder *)ctx, "{", 1); }
+static int on_end_object(void *ctx) { return record((struct recorder *)ctx, "}", 1); }
+static int on_start_array(void *ctx) { return record((struct recorder *)ctx, "[", 1); }
+static int on_end_array(void *ctx) { return record((struct recorder *)ctx, "]", 1); }
+static int on_null(void *ctx) { return record((struct recorder *)ctx, "N", 1); }
+static int on_boolean(void *ctx, int value) { return record((struct recorder *)ctx, value ? "T" : "F", 1); }
+
+static int on_key(void *ctx, const char *str, size_t len)
+{
+    record((struct recorder *)ctx, str, len);
+    return record((struct recorder *)ctx, ":", 1);
+}
+
+static int on_string(void *ctx, const char *str, size_t len)
+{
+    struct recorder *r = (struct recorder *)ctx;
+    if (r->input && str >= r->input && str < r->input + r->input_len)
+        r->views++;
+    record(r, "\"", 1);
+    record(r, str, len);
+    return record(r, "\"", 1);
+}
+
+static int on_number(void *ctx, const rjson_value *number)
+{
+    char buf[32];
+    int64_t i;
+    if (rjson_number_get_int64(number, &i) == 0 && rjson_number_get_kind(number) == RJSON_NUMBER_INT64)
+        snprintf(buf, sizeof(buf), "%lld", (long long)i);
+    else
+        snprintf(buf, sizeof(buf), "%g", rjson_number_get_double(number));
+    return record((struct recorder *)ctx, buf, strlen(buf));
+}
+
+static const rjson_sax_handler recorder_handler = {
+    on_start_object, on_end_object, on_start_array, on_end_array,
+    on_key, on_string, on_number, on_boolean, on_null};
+
+// Sums every "price" member and skips all other members' values
+struct totals
+{
+    double sum;
+    int wanted;
+    int keys;
+};
+
+static int sum_key(void *ctx, const char *str, size_t len)
+{
+    struct totals *t = (struct totals *)ctx;
+    t->keys++;
+    t->wanted = (len == 5 && memcmp(str, "price", 5) == 0);
+    return t->wanted ? RJSON_SAX_CONTINUE : RJSON_SAX_SKIP;
+}
+
+static int sum_number(void *ctx, const rjson_value *number)
+{
+    struct totals *t = (struct totals *)ctx;
+    if (t->wanted)
+        t->sum += rjson_number_get_double(number);
+    return RJSON_SAX_CONTINUE;
+}
+
+static int abort_on_null(void *ctx)
+{
+    (void)ctx;
+    return RJSON_SAX_ABORT;
+}
+
+static int skip_objects(void *ctx)
+{
+    (void)ctx;
+    return RJSON_SAX_SKIP;
+}
+
+int main()
+{
+    printf("=== Starting SAX Parser Tests ===\n");
+
+    // TEST 1: Event order and decoded payloads
+    {
+        printf("\n--- Test: Event Stream ---\n");
+        const char *json = " {\"a\": [1, -2.5, true, false, null], \"b\\u00e9\": \"x\\ny\", \"c\": {}, \"d\": 18446744073709551615} ";
+        struct recorder r = {0};
+        r.input = json;
+        r.input_len = strlen(json);
+        int rc = rjson_sax_parse(json, strlen(json), &recorder_handler, &r, NULL);
+        assert_true(rc == 0, "Should parse the document");
+        assert_true(strcmp(r.text, "{a:[1-2.5TFN]b\xC3\xA9:\"x\ny\"c:{}d:1.84467e+19}") == 0, "Should report every event in order");
+
+        struct recorder scalar = {0};
+        scalar.input = "\"plain\"";
+        scalar.input_len = 7;
+        rjson_sax_parse(scalar.input, 7, &recorder_handler, &scalar, NULL);
+        assert_true(scalar.views == 1 && strcmp(scalar.text, "\"plain\"") == 0, "Escape-free strings should not be copied");
+
+        rjson_sax_handler empty = {0};
+        assert_true(rjson_sax_parse(json, strlen(json), &empty, NULL, NULL) == 0, "Missing callbacks should continue");
+    }
+
+    // TEST 2: Invalid documents are rejected like rjson_parse_n()
+    {
+        printf("\n--- Test: Validation ---\n");
+        const char *docs[] = {"[1,]", "{\"a\" 1}", "[truex]", "[1] 2", "{\"a\":1", "", "01", "[1e999]",
+                              "\"\\ud800\"", "{1:2}", "[\"a\":1]", NULL};
+        rjson_sax_handler empty = {0};
+        for (int i = 0; docs[i]; i++)
+            assert_false(rjson_sax_parse(docs[i], strlen(docs[i]), &empty, NULL, NULL) == 0, docs[i]);
+
+        rjson_parse_options options = {0};
+        options.max_depth = 2;
+        assert_true(rjson_sax_parse("[[1]]", 5, &empty, NULL, &options) == 0, "Should accept nesting at the limit");
+        assert_false(rjson_sax_parse("[[[1]]]", 7, &empty, NULL, &options) == 0, "Should reject nesting past the limit");
+    }
+
+    // TEST 3: Aggregation in constant memory, skipping unwanted members
+    {
+        printf("\n--- Test: Aggregation ---\n");
+        const int count = 20000;
+        char *json = (char *)malloc((size_t)count * 96 + 16);
+        char *p = json;
+        *p++ = '[';
+        for (int i = 0; i < count; i++)
+            p += sprintf(p, "%s{\"id\": %d, \"price\": %d.25, \"meta\": {\"price\": 1000, \"tags\": [\"a\"]}}",
+                         i ? ", " : "", i, i % 10);
+        *p++ = ']';
+
+        struct totals t = {0};
+        rjson_sax_handler handler = {0};
+        handler.key = sum_key;
+        handler.number = sum_number;
+        int rc = rjson_sax_parse(json, (size_t)(p - json), &handler, &t, NULL);
+        assert_true(rc == 0 && t.sum == 2000 * 45 + count * 0.25, "Should sum the top-level prices");
+        assert_true(t.keys == count * 3, "Skipped values should report no keys");
+
+        p[-1] = '}'; // Mismatched bracket at the very end
+        assert_false(rjson_sax_parse(json, (size_t)(p - json), &handler, &t, NULL) == 0, "Should validate skipped data");
+        free(json);
+    }
+
+    // TEST 4: Callbacks can abort the parse or skip a subtree
+    {
+        printf("\n--- Test: Abort and Skip ---\n");
+        const char *json = "[{\"a\": [1, null]}, 2, [3, {\"b\": 4}]]";
+        struct recorder r = {0};
+        rjson_sax_handler handler = recorder_handler;
+        handler.null = abort_on_null;
+        assert_false(rjson_sax_parse(json, strlen(json), &handler, &r, NULL) == 0, "Abort should stop the parse");
+        assert_true(strcmp(r.text, "[{a:[1") == 0, "No events should follow an abort");
+
+        struct recorder skipped = {0};
+        handler = recorder_handler;
+        handler.start_object = skip_objects;
+        assert_true(rjson_sax_parse(json, strlen(json), &handler, &skipped, NULL) == 0, "Should parse with skipped objects");
+        assert_true(strcmp(skipped.text, "[2[3]]") == 0, "Skipped objects should produce no events");
+    }
+
+    printf("\n=== Summary ===\n");
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return (tests_failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,188 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h> // For strcmp
+#include "rjson.h"
+
+// ANSI Color codes
+#define GREEN "\033[0;32m"
+#define RED "\033[0;31m"
+#define RESET "\033[0m"
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+void assert_true(int condition, const char *test_name)
+{
+    if (condition)
+    {
+        printf("%s[PASS]%s %s\n", GREEN, RESET, test_name);
+        tests_passed++;
+    }
+    else
+    {
+        printf("%s[FAIL]%s %s\n", RED, RESET, test_name);
+        tests_failed++;
+    }
+}
+
+void assert_false(int condition, const char *test_name)
+{
+    assert_true(!condition, test_name);
+}
+
+// Pads `json` with trailing spaces up to 8 KiB so the parser builds a
+// structural index for it. Returns the padded length.
+static size_t pad_to_index(const char *json, char *buf, size_t cap)
+{
+    size_t len = strlen(json);
+    memcpy(buf, json, len);
+    memset(buf + len, ' ', cap - len);
+    return cap;
+}
+
+// Parses `len` bytes with and without the structural index.
+// Returns 1 if both agree on success and on the serialized result.
+static int parse_both_ways(const char *json, size_t len)
+{
+    rjson_parse_options indexed = {0};
+    rjson_parse_options scanned = {0};
+    scanned.flags = RJSON_PARSE_NO_INDEX;
+
+    rjson_value *a = rjson_parse_ex(json, len, &indexed);
+    rjson_value *b = rjson_parse_ex(json, len, &scanned);
+    int same = (a == NULL) == (b == NULL);
+    if (same && a)
+    {
+        char *sa = NULL;
+        char *sb = NULL;
+        rjson_serialize(a, &sa, NULL);
+        rjson_serialize(b, &sb, NULL);
+        same = sa && sb && strcmp(sa, sb) == 0;
+        free(sa);
+        free(sb);
+    }
+    rjson_free(a);
+    rjson_free(b);
+    return same;
+}
+
+int main()
+{
+    printf("=== Starting Structural Index Tests ===\n");
+
+    // TEST 1: A large document parses identically with and without the index
+    {
+        printf("\n--- Test: Index Round Trip ---\n");
+        const int count = 5000;
+        char *json = (char *)malloc((size_t)count * 128 + 16);
+        char *p = json;
+        *p++ = '[';
+        for (int i = 0; i < count; i++)
+            p += sprintf(p, "%s\n  {\"id\": %d, \"name\": \"user\\\"%d\\\\\", \"tags\": [true, null, -%d.5e1]}",
+                         i ? "," : "", i, i, i);
+        *p++ = ']';
+        size_t len = (size_t)(p - json);
+
+        rjson_value *doc = rjson_parse_n(json, len);
+        assert_true(doc && doc->type == RJSON_ARRAY && doc->as.arr_val.count == (size_t)count, "Should parse 5000 objects");
+        rjson_value *last = doc ? rjson_object_get_value(doc->as.arr_val.elements[count - 1], "name") : NULL;
+        assert_true(last && strcmp(last->as.str_val, "user\"4999\\") == 0, "Should honor escaped quotes and backslashes");
+        rjson_free(doc);
+        assert_true(parse_both_ways(json, len), "Indexed and byte-scanned parses should match");
+        free(json);
+    }
+
+    // TEST 2: Backslash runs and strings crossing 64-byte block boundaries
+    {
+        printf("\n--- Test: Block Boundaries ---\n");
+        char buf[8192];
+        int ok = 1;
+        for (int shift = 0; shift < 64 && ok; shift++)
+        {
+            for (int run = 1; run <= 5 && ok; run++)
+            {
+                // `shift` spaces, then a string whose backslash run straddles offset 64
+                char json[256];
+                int n = sprintf(json, "%*s[\"%.*s", shift, "", 60 - (shift % 60), "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyzabcdefgh");
+                for (int i = 0; i < run; i++)
+                    json[n++] = '\\';
+                if (run % 2)
+                    json[n++] = '"'; // Odd run: escapes a quote
+                sprintf(json + n, "\", 1, \"x\"]");
+                ok = parse_both_ways(buf, pad_to_index(json, buf, sizeof(buf)));
+            }
+        }
+        assert_true(ok, "Escape runs at every block offset should match the byte scanner");
+    }
+
+    // TEST 3: Malformed input is still rejected with an index
+    {
+        printf("\n--- Test: Index Errors ---\n");
+        const char *docs[] = {"[truex]", "[1 2]", "[12a]", "{\"a\":nullnull}", "[1] x", "[\"open]",
+                              "{\"a\" 1}", "[1,]", "[\"a\"b]", "\"\\\"", NULL};
+        char buf[8192];
+        for (int i = 0; docs[i]; i++)
+        {
+            size_t len = pad_to_index(docs[i], buf, sizeof(buf));
+            rjson_value *val = rjson_parse_n(buf, len);
+            assert_false(val != NULL, docs[i]);
+            rjson_free(val);
+        }
+    }
+
+    // TEST 4: Scalars followed directly by delimiters
+    {
+        printf("\n--- Test: Index Delimiters ---\n");
+        char buf[8192];
+        size_t len = pad_to_index("{\"a\":true,\"b\":[false,null,-0.5e+3],\"c\":{\"d\":1}}", buf, sizeof(buf));
+        rjson_value *val = rjson_parse_n(buf, len);
+        rjson_value *b = rjson_object_get_value(val, "b");
+        assert_true(b && b->as.arr_val.count == 3 && b->as.arr_val.elements[2]->as.num_val == -500.0,
+                    "Should parse compact scalars with an index");
+        rjson_free(val);
+    }
+
+    // TEST 5: Vector string scanning finds specials at every offset
+    {
+        printf("\n--- Test: String Scanning ---\n");
+        char json[256];
+        char expect[256];
+        int ok_escape = 1;
+        int ok_control = 1;
+        for (int pos = 0; pos < 150; pos++)
+        {
+            // A long plain run with one escape at `pos`, decoded normally and in place
+            memset(json, 'a', sizeof(json));
+            json[0] = '"';
+            memcpy(json + 1 + pos, "\\n", 2);
+            strcpy(json + 1 + pos + 2 + 40, "\"");
+            memset(expect, 'a', sizeof(expect));
+            expect[pos] = '\n';
+            expect[pos + 1 + 40] = '\0';
+
+            rjson_value *val = rjson_parse(json);
+            ok_escape &= val && val->as.str_len == (size_t)pos + 41 && strcmp(val->as.str_val, expect) == 0;
+            rjson_free(val);
+            val = rjson_parse_insitu(json, strlen(json), NULL);
+            ok_escape &= val && strcmp(val->as.str_val, expect) == 0;
+            rjson_free(val);
+
+            // A raw control character at `pos` must be rejected
+            memset(json, 'a', sizeof(json));
+            json[0] = '"';
+            json[1 + pos] = '\x1f';
+            strcpy(json + 1 + pos + 40, "\"");
+            val = rjson_parse(json);
+            ok_control &= val == NULL;
+            rjson_free(val);
+        }
+        assert_true(ok_escape, "Should decode an escape at every offset of a long string");
+        assert_true(ok_control, "Should reject a control character at every offset of a long string");
+    }
+
+    printf("\n=== Summary ===\n");
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return (tests_failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,172 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h> // For strcmp
+#include "rjson.h"
+
+// ANSI Color codes
+#define GREEN "\033[0;32m"
+#define RED "\033[0;31m"
+#define RESET "\033[0m"
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+void assert_true(int condition, const char *test_name)
+{
+    if (condition)
+    {
+        printf("%s[PASS]%s %s\n", GREEN, RESET, test_name);
+        tests_passed++;
+    }
+    else
+    {
+        printf("%s[FAIL]%s %s\n", RED, RESET, test_name);
+        tests_failed++;
+    }
+}
+
+void assert_false(int condition, const char *test_name)
+{
+    assert_true(!condition, test_name);
+}
+
+
+int main()
+{
+    printf("=== Starting Tape Tests ===\n");
+
+    // TEST 1: The tape serializes exactly like the tree
+    {
+        printf("\n--- Test: Tape Round Trip ---\n");
+        const char *docs[] = {
+            "{\"name\":\"Radikant\",\"tags\":[\"a\",\"b\\n\",\"\\u00e9\"],\"n\":-12.5,\"ok\":true,"
+            "\"nil\":null,\"nested\":{\"x\":[[],{}]},\"big\":18446744073709551615,\"neg\":-9007199254740993}",
+            "[]",
+            "\"just a string\"",
+            "[1,[2,[3,[4]]],{\"a\":{\"b\":{}}},false]",
+            "  42  ",
+        };
+        int ok = 1;
+        for (size_t d = 0; d < sizeof(docs) / sizeof(docs[0]); d++)
+        {
+            rjson_value *tree = rjson_parse(docs[d]);
+            rjson_tape *tape = rjson_tape_parse(docs[d], strlen(docs[d]), NULL);
+            char *tree_out = NULL;
+            char *tape_out = NULL;
+            size_t tape_len = 0;
+            ok = ok && tree && tape && rjson_serialize(tree, &tree_out, NULL) == 0 &&
+                 rjson_tape_serialize(tape, &tape_out, &tape_len) == 0 && strcmp(tree_out, tape_out) == 0 &&
+                 tape_len == strlen(tape_out);
+            free(tree_out);
+            free(tape_out);
+            rjson_free(tree);
+            rjson_tape_free(tape);
+        }
+        assert_true(ok, "Tape serialization should match the tree's");
+    }
+
+    // TEST 2: Reading values through the accessors
+    {
+        printf("\n--- Test: Tape Accessors ---\n");
+        const char *json = "{\"id\": 7, \"skip\": [[1, 2], {\"deep\": [3]}], \"name\": \"wor\\\"ker\", "
+                           "\"ratio\": 0.5, \"on\": true, \"none\": null, \"list\": [10, 20, 30]}";
+        rjson_tape *tape = rjson_tape_parse(json, strlen(json), NULL);
+        assert_true(tape != NULL, "Should parse into a tape");
+        assert_true(rjson_tape_get_type(tape, 0) == RJSON_OBJECT && rjson_tape_count(tape, 0) == 7,
+                    "Root should be an object with 7 members");
+
+        int64_t i = 0;
+        size_t id = rjson_tape_object_get_value(tape, 0, "id");
+        assert_true(rjson_tape_number_get_kind(tape, id) == RJSON_NUMBER_INT64 &&
+                        rjson_tape_number_get_int64(tape, id, &i) == 0 && i == 7,
+                    "Should read an exact integer");
+        assert_true(rjson_tape_number_get_double(tape, rjson_tape_object_get_value(tape, 0, "ratio")) == 0.5,
+                    "Should read a double");
+
+        size_t len = 0;
+        const char *name = rjson_tape_string_get(tape, rjson_tape_object_get_value(tape, 0, "name"), &len);
+        assert_true(name && len == 7 && strcmp(name, "wor\"ker") == 0, "Should read a decoded string");
+        assert_true(rjson_tape_bool_get(tape, rjson_tape_object_get_value(tape, 0, "on")) == 1,
+                    "Should read a boolean");
+        assert_true(rjson_tape_get_type(tape, rjson_tape_object_get_value(tape, 0, "none")) == RJSON_NULL,
+                    "Should read a null");
+        assert_true(rjson_tape_object_get_value(tape, 0, "deep") == 0, "Nested keys should not match at the top");
+        assert_true(rjson_tape_object_get_value(tape, 0, "missing") == 0, "Missing keys should return 0");
+
+        size_t list = rjson_tape_object_get_value(tape, 0, "list");
+        assert_true(rjson_tape_count(tape, list) == 3 &&
+                        rjson_tape_number_get_double(tape, rjson_tape_array_get(tape, list, 2)) == 30 &&
+                        rjson_tape_array_get(tape, list, 3) == 0,
+                    "Should index into an array");
+
+        size_t skip = rjson_tape_object_get_value(tape, 0, "skip");
+        assert_true(rjson_tape_count(tape, skip) == 2 && rjson_tape_count(tape, rjson_tape_first(tape, skip)) == 2,
+                    "Nested containers should know their counts");
+
+        // Walk the keys in order
+        const char *expected[] = {"id", "skip", "name", "ratio", "on", "none", "list"};
+        int ok = 1;
+        size_t n = 0;
+        for (size_t key = rjson_tape_first(tape, 0); key; key = rjson_tape_next(tape, key), n++)
+            ok = ok && n < 7 && strcmp(rjson_tape_string_get(tape, key, NULL), expected[n]) == 0;
+        assert_true(ok && n == 7, "Should iterate the keys in order, skipping subtrees");
+        rjson_tape_free(tape);
+    }
+
+    // TEST 3: Invalid documents and edge cases
+    {
+        printf("\n--- Test: Tape Errors ---\n");
+        const char *bad[] = {"", "[1, 2", "{\"a\" 1}", "[1] x", "[truex]", "{\"a\":01}"};
+        int rejected = 1;
+        for (size_t d = 0; d < sizeof(bad) / sizeof(bad[0]); d++)
+        {
+            rjson_tape *tape = rjson_tape_parse(bad[d], strlen(bad[d]), NULL);
+            rejected = rejected && tape == NULL;
+            rjson_tape_free(tape);
+        }
+        assert_true(rejected, "Should reject what rjson_parse() rejects");
+
+        rjson_parse_options options = {0};
+        options.max_depth = 2;
+        assert_false(rjson_tape_parse("[[[]]]", 6, &options) != NULL, "Should apply the depth limit");
+
+        rjson_tape *tape = rjson_tape_parse("[]", 2, NULL);
+        assert_true(tape && rjson_tape_first(tape, 0) == 0 && rjson_tape_count(tape, 0) == 0,
+                    "Empty arrays should have no first element");
+        assert_true(rjson_tape_string_get(tape, 0, NULL) == NULL && rjson_tape_get_type(tape, 99) == RJSON_NULL,
+                    "Mismatched and out-of-range indexes should be harmless");
+        rjson_tape_free(tape);
+    }
+
+    // TEST 4: A large array grows the tape and string buffer
+    {
+        printf("\n--- Test: Large Tape ---\n");
+        const int count = 20000;
+        char *json = (char *)malloc((size_t)count * 24 + 16);
+        char *p = json;
+        *p++ = '[';
+        for (int i = 0; i < count; i++)
+            p += sprintf(p, i ? ",{\"k\":\"value %d\"}" : "{\"k\":\"value %d\"}", i);
+        *p++ = ']';
+        *p = '\0';
+
+        rjson_tape *tape = rjson_tape_parse(json, strlen(json), NULL);
+        int ok = tape && rjson_tape_count(tape, 0) == (size_t)count;
+        size_t last = rjson_tape_array_get(tape, 0, (size_t)count - 1);
+        const char *value = rjson_tape_string_get(tape, rjson_tape_object_get_value(tape, last, "k"), NULL);
+        assert_true(ok && value && strcmp(value, "value 19999") == 0, "Should hold 20000 records");
+
+        char *out = NULL;
+        assert_true(rjson_tape_serialize(tape, &out, NULL) == 0 && strcmp(out, json) == 0,
+                    "Should serialize a large tape verbatim");
+        free(out);
+        rjson_tape_free(tape);
+        free(json);
+    }
+
+    printf("\n=== Summary ===\n");
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return (tests_failed == 0) ? 0 : 1;
+}